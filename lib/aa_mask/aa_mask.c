@@ -0,0 +1,39 @@
+#include "aa_mask.h"
+#include <math.h>
+#include <string.h>
+
+void aa_mask_round_rect(uint8_t *mask, uint16_t w, uint16_t h,
+                        uint16_t radius) {
+  uint16_t r = radius;
+  if (r > w / 2) {
+    r = w / 2;
+  }
+  if (r > h / 2) {
+    r = h / 2;
+  }
+
+  memset(mask, 0xFF, AA_MASK_SIZE(w, h));
+  if (r == 0) {
+    return;
+  }
+
+  // Top-left corner; the other three are mirror images
+  for (uint16_t y = 0; y < r; y++) {
+    for (uint16_t x = 0; x < r; x++) {
+      float dx = (float)r - (x + 0.5f);
+      float dy = (float)r - (y + 0.5f);
+      float cover = (float)r + 0.5f - sqrtf(dx * dx + dy * dy);
+      uint8_t a = 0xFF;
+      if (cover <= 0.0f) {
+        a = 0;
+      } else if (cover < 1.0f) {
+        a = (uint8_t)(cover * 255.0f + 0.5f);
+      }
+
+      mask[y * w + x] = a;
+      mask[y * w + (w - 1 - x)] = a;
+      mask[(h - 1 - y) * w + x] = a;
+      mask[(h - 1 - y) * w + (w - 1 - x)] = a;
+    }
+  }
+}
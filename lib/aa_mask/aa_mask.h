@@ -0,0 +1,22 @@
+#ifndef AA_MASK_H
+#define AA_MASK_H
+
+#include <stdint.h>
+
+/**
+ * @brief Bytes of a w x h A8 mask
+ */
+#define AA_MASK_SIZE(w, h) ((uint32_t)(w) * (h))
+
+/**
+ * @brief Render an anti-aliased rounded rectangle coverage mask
+ *
+ * mask is w x h A8 with a stride of w. radius is clamped to half the
+ * shorter side, so min(w, h) / 2 (or more) gives a circle or pill. Edge
+ * pixels get coverage from their centre's distance to the corner arc,
+ * like LVGL's own radius mask. Pure C so it also runs on the host.
+ */
+void aa_mask_round_rect(uint8_t *mask, uint16_t w, uint16_t h,
+                        uint16_t radius);
+
+#endif // AA_MASK_H
@@ -0,0 +1,75 @@
+#include "backlight_curve.h"
+
+/**
+ * @brief Perceptual level -> 13-bit duty
+ *
+ * Generated with CIE 1931 lightness: L = level / 255 * 100,
+ * Y = L / 903.3 (L <= 8) or ((L + 16) / 116)^3, duty = round(Y * 8191)
+ */
+static const uint16_t duty_lut[256] = {
+    0, 4, 7, 11, 14, 18, 21, 25, 28, 32, 36, 39,
+    43, 46, 50, 53, 57, 60, 64, 68, 71, 75, 78, 82,
+    86, 90, 94, 99, 103, 108, 112, 117, 122, 127, 132, 138,
+    143, 149, 155, 161, 167, 173, 180, 186, 193, 200, 207, 214,
+    222, 229, 237, 245, 253, 261, 270, 278, 287, 296, 305, 315,
+    324, 334, 344, 354, 364, 375, 386, 396, 408, 419, 430, 442,
+    454, 466, 479, 491, 504, 517, 531, 544, 558, 572, 586, 600,
+    615, 630, 645, 661, 676, 692, 708, 725, 741, 758, 775, 793,
+    810, 828, 846, 865, 883, 902, 922, 941, 961, 981, 1001, 1022,
+    1043, 1064, 1085, 1107, 1129, 1151, 1174, 1197, 1220, 1244, 1267, 1291,
+    1316, 1341, 1366, 1391, 1416, 1442, 1469, 1495, 1522, 1549, 1577, 1605,
+    1633, 1661, 1690, 1719, 1749, 1779, 1809, 1840, 1870, 1902, 1933, 1965,
+    1997, 2030, 2063, 2096, 2130, 2164, 2198, 2233, 2268, 2304, 2339, 2376,
+    2412, 2449, 2487, 2524, 2562, 2601, 2640, 2679, 2719, 2759, 2799, 2840,
+    2881, 2923, 2965, 3007, 3050, 3093, 3136, 3181, 3225, 3270, 3315, 3361,
+    3407, 3453, 3500, 3548, 3595, 3643, 3692, 3741, 3791, 3841, 3891, 3942,
+    3993, 4045, 4097, 4149, 4202, 4256, 4310, 4364, 4419, 4474, 4530, 4586,
+    4643, 4700, 4757, 4816, 4874, 4933, 4993, 5053, 5113, 5174, 5235, 5297,
+    5360, 5422, 5486, 5550, 5614, 5679, 5744, 5810, 5876, 5943, 6010, 6078,
+    6147, 6215, 6285, 6355, 6425, 6496, 6567, 6639, 6712, 6785, 6858, 6932,
+    7007, 7082, 7158, 7234, 7311, 7388, 7466, 7544, 7623, 7703, 7783, 7863,
+    7944, 8026, 8108, 8191,
+};
+
+uint32_t backlight_curve_duty(uint8_t level) { return duty_lut[level]; }
+
+uint8_t backlight_curve_level(uint32_t duty) {
+  if (duty >= BACKLIGHT_DUTY_MAX) {
+    return 255;
+  }
+
+  // Binary search for the first level whose duty is >= duty
+  int lo = 0;
+  int hi = 255;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (duty_lut[mid] < duty) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // Pick the closer of the two neighbours
+  if (lo > 0 && (duty - duty_lut[lo - 1]) < (duty_lut[lo] - duty)) {
+    lo--;
+  }
+  return (uint8_t)lo;
+}
+
+void backlight_curve_plan_fade(uint32_t current_duty, uint8_t target_level,
+                               uint32_t full_scale_ms,
+                               backlight_fade_plan_t *out_plan) {
+  uint8_t current_level = backlight_curve_level(current_duty);
+  uint32_t distance = (current_level > target_level)
+                          ? (uint32_t)(current_level - target_level)
+                          : (uint32_t)(target_level - current_level);
+
+  out_plan->target_duty = duty_lut[target_level];
+  out_plan->duration_ms = (full_scale_ms * distance) / 255;
+
+  // Too short for a hardware fade to make sense
+  if (out_plan->target_duty == current_duty || out_plan->duration_ms == 0) {
+    out_plan->duration_ms = 0;
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef BACKLIGHT_CURVE_H
+#define BACKLIGHT_CURVE_H
+
+#include <stdint.h>
+
+/**
+ * @brief PWM resolution the curve is built for (LEDC duty bits)
+ */
+#define BACKLIGHT_DUTY_BITS 13
+#define BACKLIGHT_DUTY_MAX ((1 << BACKLIGHT_DUTY_BITS) - 1)
+
+/**
+ * @brief Planned hardware fade
+ */
+typedef struct {
+  uint32_t target_duty; // Final PWM duty
+  uint32_t duration_ms; // 0 = apply immediately (no fade)
+} backlight_fade_plan_t;
+
+/**
+ * @brief Map a perceptual brightness level (0-255) to PWM duty
+ *
+ * Uses a CIE 1931 lightness curve, so equal level steps look equally bright.
+ */
+uint32_t backlight_curve_duty(uint8_t level);
+
+/**
+ * @brief Map PWM duty back to the nearest perceptual level
+ */
+uint8_t backlight_curve_level(uint32_t duty);
+
+/**
+ * @brief Plan a fade from the current duty to a perceptual level
+ *
+ * full_scale_ms is the time of a complete 0 -> 255 fade; shorter moves take
+ * proportionally less time so every fade runs at the same perceived speed,
+ * including fades that interrupt one still in progress.
+ *
+ * Pure function with no hardware dependencies (host-testable).
+ */
+void backlight_curve_plan_fade(uint32_t current_duty, uint8_t target_level,
+                               uint32_t full_scale_ms,
+                               backlight_fade_plan_t *out_plan);
+
+#endif // BACKLIGHT_CURVE_H
@@ -9,6 +9,8 @@ static const char *TAG = "CST816S";
 
 static esp_lcd_touch_handle_t touch_handle = NULL;
 static SemaphoreHandle_t touch_semaphore = NULL;
+static touch_hal_notify_cb_t notify_cb = NULL;
+static void *notify_arg = NULL;
 
 // Store config locally
 static cst816s_config_t driver_config;
@@ -17,6 +19,10 @@ static void cst816s_touch_callback(esp_lcd_touch_handle_t tp) {
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
   xSemaphoreGiveFromISR(touch_semaphore, &xHigherPriorityTaskWoken);
 
+  if (notify_cb != NULL) {
+    notify_cb(notify_arg);
+  }
+
   if (xHigherPriorityTaskWoken) {
     portYIELD_FROM_ISR();
   }
@@ -113,11 +119,18 @@ static SemaphoreHandle_t cst816s_get_semaphore_impl(void) {
   return touch_semaphore;
 }
 
+static esp_err_t cst816s_set_notify_impl(touch_hal_notify_cb_t cb, void *arg) {
+  notify_arg = arg;
+  notify_cb = cb;
+  return ESP_OK;
+}
+
 static const touch_hal_interface_t cst816s_interface = {
     .init = cst816s_init_impl,
     .deinit = cst816s_deinit_impl,
     .get_handle = cst816s_get_handle_impl,
     .get_semaphore = cst816s_get_semaphore_impl,
+    .set_notify = cst816s_set_notify_impl,
     .name = "CST816S"};
 
 const touch_hal_interface_t *cst816s_get_interface(void) {
@@ -3,6 +3,9 @@
 
 static const char *TAG = "display_hal";
 static const display_hal_interface_t *display_driver = NULL;
+static display_hal_flush_tap_t flush_taps[DISPLAY_HAL_MAX_FLUSH_TAPS];
+static volatile int flush_tap_count = 0;
+static volatile display_hal_scroll_tap_t scroll_tap = NULL;
 
 esp_err_t display_hal_register(const display_hal_interface_t *interface) {
   if (interface == NULL) {
@@ -38,6 +41,14 @@ esp_err_t display_hal_set_brightness(uint8_t level) {
   return display_driver->set_brightness(level);
 }
 
+esp_err_t display_hal_fade_brightness(uint8_t level, uint32_t full_scale_ms) {
+  if (display_driver != NULL && display_driver->fade_brightness != NULL) {
+    return display_driver->fade_brightness(level, full_scale_ms);
+  }
+
+  return display_hal_set_brightness(level);
+}
+
 esp_err_t display_hal_sleep(void) {
   if (display_driver == NULL || display_driver->sleep == NULL) {
     ESP_LOGE(TAG, "Display driver not registered or doesn't support sleep");
@@ -56,6 +67,108 @@ esp_err_t display_hal_wakeup(void) {
   return display_driver->wakeup();
 }
 
+esp_err_t display_hal_set_idle_mode(bool enable) {
+  if (display_driver == NULL || display_driver->set_idle_mode == NULL) {
+    ESP_LOGE(TAG, "Display driver not registered or doesn't support idle mode");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  return display_driver->set_idle_mode(enable);
+}
+
+esp_err_t display_hal_set_partial_mode(bool enable, uint16_t y_start,
+                                       uint16_t y_end) {
+  if (display_driver == NULL || display_driver->set_partial_mode == NULL) {
+    ESP_LOGE(TAG,
+             "Display driver not registered or doesn't support partial mode");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  if (enable && y_start > y_end) {
+    ESP_LOGE(TAG, "Invalid partial area: %d..%d", y_start, y_end);
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  return display_driver->set_partial_mode(enable, y_start, y_end);
+}
+
+esp_err_t display_hal_set_low_color_depth(bool enable) {
+  if (display_driver == NULL || display_driver->set_low_color_depth == NULL) {
+    ESP_LOGE(TAG, "Display driver not registered or doesn't support 12-bit mode");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  return display_driver->set_low_color_depth(enable);
+}
+
+esp_err_t display_hal_blit(const lv_area_t *area, const uint16_t *pixels) {
+  if (display_driver == NULL || display_driver->blit == NULL) {
+    ESP_LOGE(TAG, "Display driver not registered or doesn't support blit");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  if (area == NULL || pixels == NULL || area->x1 > area->x2 ||
+      area->y1 > area->y2) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  return display_driver->blit(area, pixels);
+}
+
+bool display_hal_supports_scroll(void) {
+  return display_driver != NULL && display_driver->scroll_define != NULL &&
+         display_driver->scroll != NULL;
+}
+
+esp_err_t display_hal_scroll_define(uint16_t top, uint16_t height) {
+  if (!display_hal_supports_scroll()) {
+    ESP_LOGE(TAG, "Display driver not registered or doesn't support scrolling");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  return display_driver->scroll_define(top, height);
+}
+
+esp_err_t display_hal_scroll(int16_t lines) {
+  if (!display_hal_supports_scroll()) {
+    ESP_LOGE(TAG, "Display driver not registered or doesn't support scrolling");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  esp_err_t ret = display_driver->scroll(lines);
+  display_hal_scroll_tap_t tap = scroll_tap;
+  if (ret == ESP_OK && tap != NULL) {
+    tap();
+  }
+  return ret;
+}
+
+void display_hal_set_scroll_tap(display_hal_scroll_tap_t tap) {
+  scroll_tap = tap;
+}
+
+esp_err_t display_hal_add_flush_tap(display_hal_flush_tap_t tap) {
+  if (tap == NULL) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (flush_tap_count >= DISPLAY_HAL_MAX_FLUSH_TAPS) {
+    ESP_LOGE(TAG, "Too many flush taps");
+    return ESP_ERR_NO_MEM;
+  }
+
+  flush_taps[flush_tap_count] = tap;
+  flush_tap_count++; // Published after the slot is filled
+  return ESP_OK;
+}
+
+void display_hal_flush_tap(const lv_area_t *area, const uint16_t *pixels) {
+  int count = flush_tap_count;
+  for (int i = 0; i < count; i++) {
+    flush_taps[i](area, pixels);
+  }
+}
+
 lv_display_t *display_hal_get_lvgl_display(void) {
   if (display_driver == NULL || display_driver->get_lvgl_display == NULL) {
     ESP_LOGE(TAG, "Display driver not registered");
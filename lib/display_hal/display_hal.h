@@ -10,12 +10,34 @@
 typedef struct {
   esp_err_t (*init)(const void *config); // Generic config pointer
   esp_err_t (*set_brightness)(uint8_t level);
+  esp_err_t (*fade_brightness)(uint8_t level, uint32_t full_scale_ms); // Optional
   esp_err_t (*sleep)(void);
   esp_err_t (*wakeup)(void);
+  esp_err_t (*set_idle_mode)(bool enable); // Reduced colour depth (optional)
+  esp_err_t (*set_partial_mode)(bool enable, uint16_t y_start,
+                                uint16_t y_end); // Optional
+  esp_err_t (*scroll_define)(uint16_t top, uint16_t height); // Optional
+  esp_err_t (*scroll)(int16_t lines);                          // Optional
+  esp_err_t (*set_low_color_depth)(bool enable); // 12-bit RGB444 (optional)
+  esp_err_t (*blit)(const lv_area_t *area,
+                    const uint16_t *pixels); // Direct RAM write (optional)
   lv_display_t *(*get_lvgl_display)(void);
   const char *name;
 } display_hal_interface_t;
 
+#define DISPLAY_HAL_MAX_FLUSH_TAPS 2
+
+/**
+ * @brief Observer for pixels about to be sent to the panel (RGB565)
+ */
+typedef void (*display_hal_flush_tap_t)(const lv_area_t *area,
+                                        const uint16_t *pixels);
+
+/**
+ * @brief Observer for hardware scroll moves (panel rows shift, no flush)
+ */
+typedef void (*display_hal_scroll_tap_t)(void);
+
 /**
  * @brief Register display driver
  */
@@ -33,6 +55,15 @@ esp_err_t display_hal_init(const void *config);
  */
 esp_err_t display_hal_set_brightness(uint8_t level);
 
+/**
+ * @brief Fade display brightness (0-255) without blocking
+ *
+ * full_scale_ms is the duration of a complete 0 -> 255 fade; smaller steps
+ * take proportionally less time. Falls back to an immediate change if the
+ * driver has no hardware fade.
+ */
+esp_err_t display_hal_fade_brightness(uint8_t level, uint32_t full_scale_ms);
+
 /**
  * @brief Put display to sleep
  */
@@ -43,6 +74,84 @@ esp_err_t display_hal_sleep(void);
  */
 esp_err_t display_hal_wakeup(void);
 
+/**
+ * @brief Enable/disable idle mode (panel reduced to 8 colours)
+ *
+ * Only the MSB of each colour channel is shown, cutting panel power.
+ */
+esp_err_t display_hal_set_idle_mode(bool enable);
+
+/**
+ * @brief Enable/disable partial display mode
+ *
+ * When enabled only rows y_start..y_end (inclusive, LVGL coordinates) are
+ * scanned; the rest of the panel is blanked.
+ */
+esp_err_t display_hal_set_partial_mode(bool enable, uint16_t y_start,
+                                       uint16_t y_end);
+
+/**
+ * @brief Switch RAM writes to 12-bit RGB444 (or back to 16-bit RGB565)
+ *
+ * Trades colour depth for 25% less bus traffic, meant for animation
+ * frames. Takes effect from the next frame; content drawn in 12-bit stays
+ * on the panel until redrawn.
+ */
+esp_err_t display_hal_set_low_color_depth(bool enable);
+
+/**
+ * @brief Write RGB565 pixels straight to the panel, bypassing LVGL
+ *
+ * pixels holds the area row by row. Serialised with the LVGL flush and
+ * returns once the data is on the bus, so pixels may be reused. LVGL
+ * keeps no framebuffer: whatever LVGL would draw there must match, or the
+ * next redraw of the area replaces the blit (see sprite_blit).
+ */
+esp_err_t display_hal_blit(const lv_area_t *area, const uint16_t *pixels);
+
+/**
+ * @brief Check whether the driver supports hardware vertical scrolling
+ */
+bool display_hal_supports_scroll(void);
+
+/**
+ * @brief Define the hardware vertical scroll area
+ *
+ * Rows top..top+height-1 (LVGL coordinates) become a ring that can be
+ * rotated with display_hal_scroll(). height = 0 removes the area. The
+ * scroll offset is reset; rows left rotated are invalidated.
+ */
+esp_err_t display_hal_scroll_define(uint16_t top, uint16_t height);
+
+/**
+ * @brief Rotate the scroll area content by a number of lines
+ *
+ * Positive values move content down. Only the newly exposed rows need to
+ * be redrawn; the new position is latched after the next LVGL refresh.
+ */
+esp_err_t display_hal_scroll(int16_t lines);
+
+/**
+ * @brief Add an observer for all panel writes
+ *
+ * Used by the framebuffer mirror and the analog face's byte counter. Taps
+ * run in the writer's context and must not block. Up to
+ * DISPLAY_HAL_MAX_FLUSH_TAPS.
+ */
+esp_err_t display_hal_add_flush_tap(display_hal_flush_tap_t tap);
+
+/**
+ * @brief Set the observer called after each display_hal_scroll()
+ *
+ * Runs in the caller's context and must not block. NULL removes it.
+ */
+void display_hal_set_scroll_tap(display_hal_scroll_tap_t tap);
+
+/**
+ * @brief Report a panel write to the tap (called by drivers)
+ */
+void display_hal_flush_tap(const lv_area_t *area, const uint16_t *pixels);
+
 /**
  * @brief Get LVGL display handle
  */
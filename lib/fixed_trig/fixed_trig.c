@@ -0,0 +1,135 @@
+#include "fixed_trig.h"
+
+#define QUARTER (FIXED_TRIG_TURN / 4)
+#define TABLE_STEPS 256
+#define STEP (QUARTER / TABLE_STEPS) // Angle units per table entry
+
+// sin(i * 90° / 256) in Q15, i = 0..256
+static const uint16_t sin_table[TABLE_STEPS + 1] = {
+    0, 201, 402, 603, 804, 1005, 1206, 1407,
+    1608, 1809, 2009, 2210, 2411, 2611, 2811, 3012,
+    3212, 3412, 3612, 3812, 4011, 4211, 4410, 4609,
+    4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+    6393, 6590, 6787, 6983, 7180, 7376, 7571, 7767,
+    7962, 8157, 8351, 8546, 8740, 8933, 9127, 9319,
+    9512, 9704, 9896, 10088, 10279, 10469, 10660, 10850,
+    11039, 11228, 11417, 11605, 11793, 11980, 12167, 12354,
+    12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+    14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269,
+    15447, 15624, 15800, 15976, 16151, 16326, 16500, 16673,
+    16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+    18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358,
+    19520, 19681, 19841, 20001, 20160, 20318, 20475, 20632,
+    20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+    22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028,
+    23170, 23312, 23453, 23593, 23732, 23870, 24008, 24144,
+    24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+    25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199,
+    26320, 26439, 26557, 26674, 26791, 26906, 27020, 27133,
+    27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+    28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803,
+    28899, 28993, 29086, 29178, 29269, 29359, 29448, 29535,
+    29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+    30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784,
+    30853, 30920, 30986, 31050, 31114, 31177, 31238, 31298,
+    31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+    31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099,
+    32138, 32177, 32214, 32251, 32286, 32319, 32352, 32383,
+    32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+    32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718,
+    32729, 32738, 32746, 32753, 32758, 32762, 32766, 32767,
+    32768,
+};
+
+int32_t fixed_sin(int32_t angle) {
+  angle &= FIXED_TRIG_TURN - 1;
+
+  int32_t a = angle % QUARTER;
+  if ((angle / QUARTER) & 1) {
+    a = QUARTER - a; // Falling quarter
+  }
+  int32_t i = a / STEP;
+  int32_t frac = a % STEP;
+  int32_t value = sin_table[i];
+  if (frac != 0) {
+    value += ((int32_t)(sin_table[i + 1] - sin_table[i]) * frac) / STEP;
+  }
+  return (angle >= FIXED_TRIG_TURN / 2) ? -value : value;
+}
+
+int32_t fixed_cos(int32_t angle) { return fixed_sin(angle + QUARTER); }
+
+void fixed_trig_point(int32_t cx, int32_t cy, int32_t angle, int32_t r,
+                      int32_t *x, int32_t *y) {
+  // Clock angle: x follows sin, y follows -cos
+  int32_t dx = r * fixed_sin(angle);
+  int32_t dy = -r * fixed_cos(angle);
+  *x = cx + ((dx + (dx >= 0 ? FIXED_TRIG_ONE / 2 : -FIXED_TRIG_ONE / 2)) /
+             FIXED_TRIG_ONE);
+  *y = cy + ((dy + (dy >= 0 ? FIXED_TRIG_ONE / 2 : -FIXED_TRIG_ONE / 2)) /
+             FIXED_TRIG_ONE);
+}
+
+static void box_add(fixed_trig_box_t *box, int32_t x, int32_t y) {
+  if (x < box->x1) {
+    box->x1 = x;
+  }
+  if (x > box->x2) {
+    box->x2 = x;
+  }
+  if (y < box->y1) {
+    box->y1 = y;
+  }
+  if (y > box->y2) {
+    box->y2 = y;
+  }
+}
+
+/**
+ * @brief Add the extremes of an arc of radius r swept over span from from
+ *
+ * The arc's ends are added separately; only axis directions strictly
+ * inside it can reach further out.
+ */
+static void box_add_arc(fixed_trig_box_t *box, int32_t cx, int32_t cy,
+                        int32_t from, int32_t span, int32_t r) {
+  int32_t next = (from / QUARTER + 1) * QUARTER;
+  for (int32_t axis = next; axis < from + span; axis += QUARTER) {
+    int32_t x;
+    int32_t y;
+    fixed_trig_point(cx, cy, axis, r, &x, &y);
+    box_add(box, x, y);
+  }
+}
+
+void fixed_trig_sweep_box(int32_t cx, int32_t cy, int32_t from, int32_t to,
+                          int32_t r0, int32_t r1, int32_t pad,
+                          fixed_trig_box_t *box) {
+  from &= FIXED_TRIG_TURN - 1;
+  int32_t span = (to - from) & (FIXED_TRIG_TURN - 1);
+
+  int32_t x;
+  int32_t y;
+  fixed_trig_point(cx, cy, from, r0, &x, &y);
+  box->x1 = box->x2 = x;
+  box->y1 = box->y2 = y;
+  fixed_trig_point(cx, cy, from, r1, &x, &y);
+  box_add(box, x, y);
+  fixed_trig_point(cx, cy, from + span, r0, &x, &y);
+  box_add(box, x, y);
+  fixed_trig_point(cx, cy, from + span, r1, &x, &y);
+  box_add(box, x, y);
+
+  // The inner arc never reaches past the outer one or the ends
+  if (r1 > 0) {
+    box_add_arc(box, cx, cy, from, span, r1);
+  }
+  if (r0 < 0) {
+    box_add_arc(box, cx, cy, from + FIXED_TRIG_TURN / 2, span, -r0);
+  }
+
+  box->x1 -= pad;
+  box->y1 -= pad;
+  box->x2 += pad;
+  box->y2 += pad;
+}
@@ -0,0 +1,59 @@
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <stdint.h>
+
+/**
+ * @brief Angle units in a full turn (0 = 12 o'clock, clockwise)
+ */
+#define FIXED_TRIG_TURN 4096
+
+/**
+ * @brief Fixed-point 1.0 of fixed_sin() and fixed_cos() (Q15)
+ */
+#define FIXED_TRIG_ONE 32768
+
+/**
+ * @brief Axis-aligned box, inclusive on all sides
+ */
+typedef struct {
+  int32_t x1, y1, x2, y2;
+} fixed_trig_box_t;
+
+/**
+ * @brief Sine of a FIXED_TRIG_TURN angle in Q15
+ *
+ * From a 257-entry quarter-wave table with linear interpolation, so no
+ * floating point. Any angle is accepted (taken modulo a turn).
+ */
+int32_t fixed_sin(int32_t angle);
+
+/**
+ * @brief Cosine of a FIXED_TRIG_TURN angle in Q15
+ */
+int32_t fixed_cos(int32_t angle);
+
+/**
+ * @brief Point at radius r from (cx, cy) in clock direction angle
+ *
+ * Screen coordinates (y down), rounded to the nearest pixel. A negative r
+ * points the other way (a hand's tail).
+ */
+void fixed_trig_point(int32_t cx, int32_t cy, int32_t angle, int32_t r,
+                      int32_t *x, int32_t *y);
+
+/**
+ * @brief Bounding box of part of a hand swept clockwise from from to to
+ *
+ * The part runs from radius r0 to r1 (r0 < r1, negative = the tail behind
+ * (cx, cy)). The box covers both end positions and the outer arcs,
+ * including where they cross the 3, 6, 9 and 12 o'clock directions, and
+ * is grown by pad (half the hand width plus anti-aliasing). It is exact to
+ * the pixel, so a hand cut into a few parts invalidates far less than one
+ * box around it when diagonal. from == to gives the part's own box.
+ */
+void fixed_trig_sweep_box(int32_t cx, int32_t cy, int32_t from, int32_t to,
+                          int32_t r0, int32_t r1, int32_t pad,
+                          fixed_trig_box_t *box);
+
+#endif // FIXED_TRIG_H
@@ -0,0 +1,88 @@
+#include "rgb444_pack.h"
+
+// 4x4 Bayer threshold matrix, scaled to an 8-bit rounding offset
+static const uint8_t bayer_offset[4][4] = {
+    {8, 136, 40, 168},
+    {200, 72, 232, 104},
+    {56, 184, 24, 152},
+    {248, 120, 216, 88},
+};
+
+void rgb444_pack(const uint16_t *src, uint8_t *dst, size_t pixels) {
+  size_t pairs = pixels / 2;
+
+  for (size_t i = 0; i < pairs; i++) {
+    // Read both pixels before writing - keeps in-place packing safe
+    uint16_t p0 = src[0];
+    uint16_t p1 = src[1];
+    src += 2;
+
+    dst[0] = ((p0 >> 8) & 0xF0) | ((p0 >> 7) & 0x0F); // R0 G0
+    dst[1] = ((p0 << 3) & 0xF0) | (p1 >> 12);         // B0 R1
+    dst[2] = ((p1 >> 3) & 0xF0) | ((p1 >> 1) & 0x0F); // G1 B1
+    dst += 3;
+  }
+
+  if (pixels & 1) {
+    uint16_t p0 = src[0];
+    dst[0] = ((p0 >> 8) & 0xF0) | ((p0 >> 7) & 0x0F);
+    dst[1] = (p0 << 3) & 0xF0;
+  }
+}
+
+/**
+ * @brief Quantise an 8-bit channel to 4 bits with a dither offset
+ */
+static inline uint8_t dither_channel(uint32_t c8, uint32_t offset) {
+  uint32_t c = c8 + (c8 >> 7); // 0..256, so full scale maps to 15 exactly
+  return (c * 15 + offset) >> 8;
+}
+
+static inline uint16_t dither_pixel(uint16_t p, uint32_t offset) {
+  uint32_t r8 = ((p >> 8) & 0xF8) | (p >> 13);
+  uint32_t g8 = ((p >> 3) & 0xFC) | ((p >> 9) & 0x03);
+  uint32_t b8 = ((p << 3) & 0xF8) | ((p >> 2) & 0x07);
+
+  return (dither_channel(r8, offset) << 8) |
+         (dither_channel(g8, offset) << 4) | dither_channel(b8, offset);
+}
+
+void rgb444_pack_dither(const uint16_t *src, uint8_t *dst, uint16_t width,
+                        uint16_t rows, uint16_t x0, uint16_t y0) {
+  size_t total = (size_t)width * rows;
+  uint16_t x = x0;
+  uint16_t y = y0;
+  uint16_t col = 0;
+
+  for (size_t i = 0; i + 1 < total; i += 2) {
+    uint16_t q0 = dither_pixel(src[0], bayer_offset[y & 3][x & 3]);
+    if (++col == width) {
+      col = 0;
+      x = x0;
+      y++;
+    } else {
+      x++;
+    }
+
+    uint16_t q1 = dither_pixel(src[1], bayer_offset[y & 3][x & 3]);
+    if (++col == width) {
+      col = 0;
+      x = x0;
+      y++;
+    } else {
+      x++;
+    }
+    src += 2;
+
+    dst[0] = q0 >> 4;
+    dst[1] = ((q0 & 0x0F) << 4) | (q1 >> 8);
+    dst[2] = q1 & 0xFF;
+    dst += 3;
+  }
+
+  if (total & 1) {
+    uint16_t q0 = dither_pixel(src[0], bayer_offset[y & 3][x & 3]);
+    dst[0] = q0 >> 4;
+    dst[1] = (q0 & 0x0F) << 4;
+  }
+}
@@ -0,0 +1,30 @@
+#ifndef RGB444_PACK_H
+#define RGB444_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Bytes needed for a packed RGB444 run (two pixels per 3 bytes)
+ */
+#define RGB444_PACKED_SIZE(pixels) (((pixels) * 3 + 1) / 2)
+
+/**
+ * @brief Pack RGB565 pixels into the panel's 12-bit RGB444 byte stream
+ *
+ * Each channel keeps its top 4 bits. pixels should be even; an odd last
+ * pixel is padded. dst may equal src (in-place packing is safe because
+ * the output never overtakes the input).
+ */
+void rgb444_pack(const uint16_t *src, uint8_t *dst, size_t pixels);
+
+/**
+ * @brief Pack with 4x4 ordered (Bayer) dithering
+ *
+ * src is a width x rows block whose top-left pixel sits at x0, y0 on the
+ * screen, so the pattern stays fixed while content moves. In-place safe.
+ */
+void rgb444_pack_dither(const uint16_t *src, uint8_t *dst, uint16_t width,
+                        uint16_t rows, uint16_t x0, uint16_t y0);
+
+#endif // RGB444_PACK_H
@@ -0,0 +1,154 @@
+#include "rle565.h"
+
+// Runs shorter than this are cheaper as literals
+#define RLE565_MIN_RUN 3
+
+static size_t run_length(const uint16_t *px, size_t remaining) {
+  size_t n = 1;
+  while (n < remaining && n < RLE565_MAX_COUNT && px[n] == px[0]) {
+    n++;
+  }
+  return n;
+}
+
+/**
+ * @brief Encode a stretch without skips
+ */
+static size_t encode_span(const uint16_t *px, size_t count, uint8_t *out,
+                          size_t out_cap) {
+  size_t pos = 0;
+  size_t i = 0;
+
+  while (i < count) {
+    size_t run = run_length(px + i, count - i);
+    if (run >= RLE565_MIN_RUN) {
+      if (pos + 3 > out_cap) {
+        return 0;
+      }
+      out[pos++] = RLE565_OP_RUN | (run - 1);
+      out[pos++] = px[i] & 0xFF;
+      out[pos++] = px[i] >> 8;
+      i += run;
+      continue;
+    }
+
+    // Literal stretch up to the next worthwhile run
+    size_t lit = 0;
+    while (i + lit < count && lit < RLE565_MAX_COUNT &&
+           run_length(px + i + lit, count - i - lit) < RLE565_MIN_RUN) {
+      lit++;
+    }
+    if (lit == 0) {
+      lit = 1;
+    }
+
+    if (pos + 1 + lit * 2 > out_cap) {
+      return 0;
+    }
+    out[pos++] = RLE565_OP_LIT | (lit - 1);
+    for (size_t k = 0; k < lit; k++) {
+      out[pos++] = px[i + k] & 0xFF;
+      out[pos++] = px[i + k] >> 8;
+    }
+    i += lit;
+  }
+
+  return pos;
+}
+
+size_t rle565_encode(const uint16_t *px, size_t count,
+                     const rle565_skip_t *skips, size_t skip_count,
+                     uint8_t *out, size_t out_cap) {
+  size_t pos = 0;
+  size_t i = 0;
+
+  for (size_t s = 0; s <= skip_count; s++) {
+    size_t span_end = (s < skip_count) ? skips[s].start : count;
+    if (span_end > count || span_end < i) {
+      return 0; // Unsorted or out of range
+    }
+
+    if (span_end > i) {
+      size_t n = encode_span(px + i, span_end - i, out + pos, out_cap - pos);
+      if (n == 0) {
+        return 0;
+      }
+      pos += n;
+      i = span_end;
+    }
+
+    if (s == skip_count) {
+      break;
+    }
+
+    size_t skip_end = skips[s].start + skips[s].len;
+    if (skip_end > count) {
+      return 0;
+    }
+    while (i < skip_end) {
+      size_t n = skip_end - i;
+      if (n > RLE565_MAX_COUNT) {
+        n = RLE565_MAX_COUNT;
+      }
+      if (pos + 1 > out_cap) {
+        return 0;
+      }
+      out[pos++] = RLE565_OP_SKIP | (n - 1);
+      i += n;
+    }
+  }
+
+  return pos;
+}
+
+size_t rle565_decode(const uint8_t *in, size_t in_len, uint16_t *px,
+                     size_t count) {
+  size_t pos = 0;
+  size_t i = 0;
+
+  while (i < count) {
+    if (pos >= in_len) {
+      return 0;
+    }
+
+    uint8_t op = in[pos++];
+    size_t n = (op & 0x3F) + 1;
+    if (i + n > count) {
+      return 0;
+    }
+
+    switch (op & 0xC0) {
+    case RLE565_OP_SKIP:
+      break;
+
+    case RLE565_OP_RUN: {
+      if (pos + 2 > in_len) {
+        return 0;
+      }
+      uint16_t value = in[pos] | (in[pos + 1] << 8);
+      pos += 2;
+      for (size_t k = 0; k < n; k++) {
+        px[i + k] = value;
+      }
+      break;
+    }
+
+    case RLE565_OP_LIT:
+      if (pos + n * 2 > in_len) {
+        return 0;
+      }
+      for (size_t k = 0; k < n; k++) {
+        px[i + k] = in[pos] | (in[pos + 1] << 8);
+        pos += 2;
+      }
+      break;
+
+    default:
+      return 0;
+    }
+
+    i += n;
+  }
+
+  return pos;
+}
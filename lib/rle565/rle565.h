@@ -0,0 +1,57 @@
+#ifndef RLE565_H
+#define RLE565_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Run-length codec for RGB565 pixel streams
+ *
+ * The stream is a sequence of ops; the top two bits of each op byte give
+ * its type and the low six bits the pixel count minus one (1..64):
+ *   SKIP n - keep n pixels of the previous content (no data)
+ *   RUN n  - one little-endian pixel repeated n times
+ *   LIT n  - n little-endian pixels
+ * Pure C so the same code runs on the host (see tools/fb_mirror.py for
+ * the matching Python decoder).
+ */
+#define RLE565_OP_SKIP 0x00
+#define RLE565_OP_RUN 0x40
+#define RLE565_OP_LIT 0x80
+#define RLE565_MAX_COUNT 64
+
+/**
+ * @brief Worst-case encoded size (all literals, no skips)
+ */
+#define RLE565_MAX_ENCODED_SIZE(pixels)                                        \
+  ((pixels) * 2 + ((pixels) + RLE565_MAX_COUNT - 1) / RLE565_MAX_COUNT)
+
+/**
+ * @brief Range of pixels the decoder already has (delta against the
+ * previous frame)
+ */
+typedef struct {
+  uint16_t start;
+  uint16_t len;
+} rle565_skip_t;
+
+/**
+ * @brief Encode count pixels
+ *
+ * skips must be sorted and non-overlapping (may be NULL). Returns the
+ * encoded size, or 0 if out_cap is too small.
+ */
+size_t rle565_encode(const uint16_t *px, size_t count,
+                     const rle565_skip_t *skips, size_t skip_count,
+                     uint8_t *out, size_t out_cap);
+
+/**
+ * @brief Decode into px, which holds the previous content for skips
+ *
+ * Returns the number of input bytes consumed, or 0 if the input is
+ * malformed or does not produce exactly count pixels.
+ */
+size_t rle565_decode(const uint8_t *in, size_t in_len, uint16_t *px,
+                     size_t count);
+
+#endif // RLE565_H
@@ -1,12 +1,22 @@
 #include "st7789_driver.h"
+#include "backlight_curve.h"
+#include "rgb444_pack.h"
+#include "st7789_scroll.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 #include "driver/ledc.h"
+#include "esp_lcd_panel_commands.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_vendor.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include <stdatomic.h>
+#include <string.h>
 
 static const char *TAG = "ST7789";
 
@@ -18,22 +28,66 @@ static const char *TAG = "ST7789";
 #define LCD_BITS_PER_PIXEL 16
 #define LCD_DRAW_BUFF_DOUBLE 1
 #define LCD_DRAW_BUFF_HEIGHT 50
+#define LCD_MIRROR_X true
+#define LCD_MIRROR_Y true
+#define LCD_X_GAP 0
+#define LCD_Y_GAP 20 // 280-row glass centred in the 320-row controller RAM
+#define LCD_RAM_ROWS 320
+#define BLIT_BUF_PIXELS 1024 // DMA bounce buffer for display_hal_blit()
+#define TRANS_FIFO_SIZE 32   // > IO queue depth
 
 // PWM settings for backlight
 #define LEDC_TIMER              LEDC_TIMER_0
 #define LEDC_MODE               LEDC_LOW_SPEED_MODE
 #define LEDC_CHANNEL            LEDC_CHANNEL_0
-#define LEDC_DUTY_RES           LEDC_TIMER_8_BIT
+#define LEDC_DUTY_RES           BACKLIGHT_DUTY_BITS
 #define LEDC_FREQUENCY          (5000)
 
+// Backlight fade times (for a full 0 -> 255 sweep)
+#define BL_FADE_WAKE_MS         250
+#define BL_FADE_SLEEP_MS        400
+
 static esp_lcd_panel_io_handle_t lcd_io = NULL;
 static esp_lcd_panel_handle_t lcd_panel = NULL;
 static lv_display_t *lvgl_disp = NULL;
 static bool pwm_initialized = false;
+static uint8_t backlight_level = 255;      // Level restored on wakeup
+static esp_timer_handle_t panel_off_timer = NULL; // Panel off after fade-out
+static bool panel_off_pending = false;            // Guarded by bus_lock
+
+// Flush bookkeeping: one LVGL flush may need several RAM writes
+static atomic_int flush_trans_pending = 0;
+
+// Owner of each queued colour transfer, in bus order
+enum { TRANS_OWNER_FLUSH, TRANS_OWNER_BLIT };
+static uint8_t trans_fifo[TRANS_FIFO_SIZE];
+static atomic_uint trans_head = 0;
+static atomic_uint trans_tail = 0;
+
+static SemaphoreHandle_t bus_lock = NULL;  // Serialises panel commands/RAM
+static SemaphoreHandle_t blit_done = NULL; // Blit transfer finished
+static uint16_t *blit_buf = NULL;
+
+// RAM addressing and hardware vertical scroll state
+static st7789_scroll_t scroll;
+static bool scroll_start_pending = false;
+
+// Colour depth of RAM writes: 12-bit sends 25% fewer bytes
+static bool color_12bit = false;
+static volatile bool color_12bit_requested = false;
 
 // Store config locally
 static st7789_config_t driver_config;
 
+static void st7789_panel_off_cb(void *arg);
+static void st7789_flush_cb(lv_display_t *disp, const lv_area_t *area,
+                            uint8_t *px_map);
+static bool st7789_color_done_cb(esp_lcd_panel_io_handle_t io,
+                                 esp_lcd_panel_io_event_data_t *edata,
+                                 void *user_ctx);
+static void st7789_refr_ready_cb(lv_event_t *e);
+static void st7789_rounder_cb(lv_event_t *e);
+
 static esp_err_t st7789_init_impl(const void *config) {
   if (config == NULL) {
     ESP_LOGE(TAG, "Config is NULL");
@@ -100,13 +154,15 @@ static esp_err_t st7789_init_impl(const void *config) {
   esp_lcd_panel_reset(lcd_panel);
   esp_lcd_panel_init(lcd_panel);
   esp_lcd_panel_invert_color(lcd_panel, true);
-  esp_lcd_panel_mirror(lcd_panel, true, true);
+  esp_lcd_panel_mirror(lcd_panel, LCD_MIRROR_X, LCD_MIRROR_Y);
   esp_lcd_panel_disp_on_off(lcd_panel, true);
 
   // Backlight on
   gpio_set_level(driver_config.pin_bl, 1);
 
-  esp_lcd_panel_set_gap(lcd_panel, 0, 20);
+  esp_lcd_panel_set_gap(lcd_panel, LCD_X_GAP, LCD_Y_GAP);
+  st7789_scroll_init(&scroll, LCD_X_GAP, LCD_Y_GAP, LCD_RAM_ROWS,
+                     LCD_MIRROR_Y);
 
   // LVGL display
   const lvgl_port_display_cfg_t disp_cfg = {
@@ -132,6 +188,27 @@ static esp_err_t st7789_init_impl(const void *config) {
     return ESP_FAIL;
   }
 
+  bus_lock = xSemaphoreCreateMutex();
+  blit_done = xSemaphoreCreateBinary();
+  blit_buf = heap_caps_malloc(BLIT_BUF_PIXELS * sizeof(uint16_t),
+                              MALLOC_CAP_DMA);
+  if (bus_lock == NULL || blit_done == NULL || blit_buf == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate flush resources");
+    return ESP_ERR_NO_MEM;
+  }
+
+  // Take over the flush path from esp_lvgl_port: RAM writes go through the
+  // hardware scroll mapping
+  const esp_lcd_panel_io_callbacks_t io_cbs = {
+      .on_color_trans_done = st7789_color_done_cb,
+  };
+  esp_lcd_panel_io_register_event_callbacks(lcd_io, &io_cbs, NULL);
+  lv_display_set_flush_cb(lvgl_disp, st7789_flush_cb);
+  lv_display_add_event_cb(lvgl_disp, st7789_refr_ready_cb, LV_EVENT_REFR_READY,
+                          NULL);
+  lv_display_add_event_cb(lvgl_disp, st7789_rounder_cb,
+                          LV_EVENT_INVALIDATE_AREA, NULL);
+
   // Initialize PWM for backlight
   ledc_timer_config_t ledc_timer = {
     .speed_mode       = LEDC_MODE,
@@ -152,7 +229,7 @@ static esp_err_t st7789_init_impl(const void *config) {
     .timer_sel      = LEDC_TIMER,
     .intr_type      = LEDC_INTR_DISABLE,
     .gpio_num       = driver_config.pin_bl,
-    .duty           = 255, // Start at full brightness
+    .duty           = backlight_curve_duty(backlight_level), // Full brightness
     .hpoint         = 0
   };
   ret = ledc_channel_config(&ledc_channel);
@@ -160,6 +237,23 @@ static esp_err_t st7789_init_impl(const void *config) {
     ESP_LOGE(TAG, "Failed to configure LEDC channel");
     return ret;
   }
+
+  // Hardware fades run without CPU involvement
+  ret = ledc_fade_func_install(0);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to install LEDC fade");
+    return ret;
+  }
+
+  const esp_timer_create_args_t off_timer_args = {
+      .callback = st7789_panel_off_cb,
+      .name = "st7789_off",
+  };
+  ret = esp_timer_create(&off_timer_args, &panel_off_timer);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create panel off timer");
+    return ret;
+  }
   
   pwm_initialized = true;
 
@@ -167,32 +261,437 @@ static esp_err_t st7789_init_impl(const void *config) {
   return ESP_OK;
 }
 
+/**
+ * @brief Start a (non-blocking) backlight fade to a perceptual level
+ *
+ * Interrupts any fade in progress and continues from the current duty.
+ *
+ * @param out_duration_ms Actual fade duration (optional)
+ */
+static esp_err_t st7789_backlight_fade(uint8_t level, uint32_t full_scale_ms,
+                                       uint32_t *out_duration_ms) {
+  // Freeze a running fade so we start from where it got to
+  ledc_fade_stop(LEDC_MODE, LEDC_CHANNEL);
+
+  backlight_fade_plan_t plan;
+  backlight_curve_plan_fade(ledc_get_duty(LEDC_MODE, LEDC_CHANNEL), level,
+                            full_scale_ms, &plan);
+
+  if (out_duration_ms != NULL) {
+    *out_duration_ms = plan.duration_ms;
+  }
+
+  if (plan.duration_ms == 0) {
+    esp_err_t ret = ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, plan.target_duty);
+    if (ret != ESP_OK) return ret;
+    return ledc_update_duty(LEDC_MODE, LEDC_CHANNEL);
+  }
+
+  esp_err_t ret = ledc_set_fade_with_time(LEDC_MODE, LEDC_CHANNEL,
+                                          plan.target_duty, plan.duration_ms);
+  if (ret != ESP_OK) return ret;
+
+  return ledc_fade_start(LEDC_MODE, LEDC_CHANNEL, LEDC_FADE_NO_WAIT);
+}
+
+/**
+ * @brief Switch the panel on or off between RAM writes
+ *
+ * Also cancels a panel-off the sleep timer has yet to send.
+ */
+static esp_err_t st7789_panel_power(bool on) {
+  if (bus_lock == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  panel_off_pending = false;
+  esp_err_t ret = esp_lcd_panel_disp_on_off(lcd_panel, on);
+  xSemaphoreGive(bus_lock);
+  return ret;
+}
+
+/**
+ * @brief Turn the panel off once the sleep fade-out has finished
+ *
+ * Runs in the esp_timer task. A wakeup may get the bus first even after
+ * esp_timer_stop() missed us, so only send DISPOFF if still wanted.
+ */
+static void st7789_panel_off_cb(void *arg) {
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  if (panel_off_pending) {
+    panel_off_pending = false;
+    esp_lcd_panel_disp_on_off(lcd_panel, false);
+  }
+  xSemaphoreGive(bus_lock);
+}
+
 static esp_err_t st7789_set_brightness_impl(uint8_t level) {
   if (!pwm_initialized) {
     ESP_LOGW(TAG, "PWM not initialized");
     return ESP_ERR_INVALID_STATE;
   }
-  
-  esp_err_t ret = ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, level);
-  if (ret != ESP_OK) return ret;
-  
-  return ledc_update_duty(LEDC_MODE, LEDC_CHANNEL);
+
+  backlight_level = level;
+  return st7789_backlight_fade(level, 0, NULL);
+}
+
+static esp_err_t st7789_fade_brightness_impl(uint8_t level,
+                                             uint32_t full_scale_ms) {
+  if (!pwm_initialized) {
+    ESP_LOGW(TAG, "PWM not initialized");
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  backlight_level = level;
+  return st7789_backlight_fade(level, full_scale_ms, NULL);
 }
 
 static esp_err_t st7789_sleep_impl(void) {
-  if (pwm_initialized) {
-    ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, 0);
-    ledc_update_duty(LEDC_MODE, LEDC_CHANNEL);
+  if (!pwm_initialized) {
+    return st7789_panel_power(false);
+  }
+
+  uint32_t duration_ms = 0;
+  esp_err_t ret = st7789_backlight_fade(0, BL_FADE_SLEEP_MS, &duration_ms);
+  if (ret != ESP_OK || duration_ms == 0) {
+    return st7789_panel_power(false);
   }
-  return esp_lcd_panel_disp_on_off(lcd_panel, false);
+
+  esp_timer_stop(panel_off_timer);
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  panel_off_pending = true;
+  xSemaphoreGive(bus_lock);
+  return esp_timer_start_once(panel_off_timer, (uint64_t)duration_ms * 1000);
 }
 
 static esp_err_t st7789_wakeup_impl(void) {
-  esp_err_t ret = esp_lcd_panel_disp_on_off(lcd_panel, true);
+  if (panel_off_timer != NULL) {
+    esp_timer_stop(panel_off_timer); // Cancel a pending sleep
+  }
+
+  esp_err_t ret = st7789_panel_power(true);
   if (pwm_initialized) {
-    ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, 255);
-    ledc_update_duty(LEDC_MODE, LEDC_CHANNEL);
+    st7789_backlight_fade(backlight_level, BL_FADE_WAKE_MS, NULL);
+  }
+  return ret;
+}
+
+/**
+ * @brief Command sink for st7789_scroll
+ */
+static int st7789_tx_param(void *ctx, uint8_t cmd, const uint8_t *params,
+                           size_t len) {
+  return esp_lcd_panel_io_tx_param(lcd_io, cmd, params, len);
+}
+
+/**
+ * @brief Write a block of rows to panel RAM
+ */
+static esp_err_t st7789_write_window(int x1, int x2, uint16_t raset_start,
+                                     uint16_t rows, const void *data,
+                                     size_t len) {
+  esp_err_t ret = st7789_scroll_send_window(&scroll, x1, x2, raset_start, rows,
+                                            st7789_tx_param, NULL);
+  if (ret != ESP_OK) return ret;
+  return esp_lcd_panel_io_tx_color(lcd_io, LCD_CMD_RAMWR, data, len);
+}
+
+static void st7789_flush_done(lv_display_t *disp) {
+  if (atomic_fetch_sub(&flush_trans_pending, 1) == 1) {
+    lv_display_flush_ready(disp);
+  }
+}
+
+/**
+ * @brief Colour transfer finished (ISR) - hand it back to its owner
+ *
+ * Transfers complete in queue order, so the tag FIFO tells LVGL flushes
+ * and blits apart.
+ */
+static bool st7789_color_done_cb(esp_lcd_panel_io_handle_t io,
+                                 esp_lcd_panel_io_event_data_t *edata,
+                                 void *user_ctx) {
+  unsigned tail = atomic_fetch_add(&trans_tail, 1);
+  if (trans_fifo[tail % TRANS_FIFO_SIZE] == TRANS_OWNER_FLUSH) {
+    st7789_flush_done(lvgl_disp);
+    return false;
+  }
+
+  BaseType_t need_yield = pdFALSE;
+  xSemaphoreGiveFromISR(blit_done, &need_yield);
+  return need_yield == pdTRUE;
+}
+
+/**
+ * @brief Queue one RAM write (bus lock held)
+ */
+static esp_err_t st7789_queue_write(uint8_t owner, int x1, int x2,
+                                    uint16_t raset, uint16_t rows,
+                                    const void *data, size_t len) {
+  unsigned head = atomic_load(&trans_head);
+  if (head - atomic_load(&trans_tail) >= TRANS_FIFO_SIZE) {
+    return ESP_ERR_NO_MEM; // Can't happen with the IO queue depth used here
+  }
+
+  trans_fifo[head % TRANS_FIFO_SIZE] = owner;
+  atomic_store(&trans_head, head + 1);
+
+  esp_err_t ret = st7789_write_window(x1, x2, raset, rows, data, len);
+  if (ret != ESP_OK) {
+    atomic_store(&trans_head, head); // Never queued, no callback will come
+  }
+  return ret;
+}
+
+/**
+ * @brief Apply a requested colour depth change (bus lock held)
+ *
+ * Depth changes take effect between frames; COLMOD waits for the bus.
+ */
+static void st7789_update_color_depth(void) {
+  bool want_12bit = color_12bit_requested;
+  if (want_12bit != color_12bit) {
+    const uint8_t colmod = want_12bit ? 0x53 : 0x55;
+    esp_lcd_panel_io_tx_param(lcd_io, LCD_CMD_COLMOD, &colmod, 1);
+    color_12bit = want_12bit;
+  }
+}
+
+/**
+ * @brief LVGL flush - splits the area into runs of consecutive RAM rows
+ *
+ * Without hardware scrolling this is a single write, like
+ * esp_lcd_panel_draw_bitmap().
+ */
+static void st7789_flush_cb(lv_display_t *disp, const lv_area_t *area,
+                            uint8_t *px_map) {
+  const int w = lv_area_get_width(area);
+  size_t row_bytes = w * sizeof(uint16_t);
+
+  display_hal_flush_tap(area, (const uint16_t *)px_map);
+
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  st7789_update_color_depth();
+
+  if (color_12bit) {
+    // Packed in place; the draw buffer is re-rendered for every flush
+    if (driver_config.rgb444_dither) {
+      rgb444_pack_dither((const uint16_t *)px_map, px_map, w,
+                         lv_area_get_height(area), area->x1, area->y1);
+    } else {
+      rgb444_pack((const uint16_t *)px_map, px_map,
+                  (size_t)w * lv_area_get_height(area));
+    }
+    row_bytes = RGB444_PACKED_SIZE(w); // Exact: width is kept even
+  }
+
+  // Guard reference: flush_ready can't fire before every run is queued
+  atomic_store(&flush_trans_pending, 1);
+
+  int y = area->y1;
+  while (y <= area->y2) {
+    uint16_t raset;
+    uint16_t rows = st7789_scroll_find_run(&scroll, y, area->y2, &raset);
+
+    atomic_fetch_add(&flush_trans_pending, 1);
+    esp_err_t ret = st7789_queue_write(
+        TRANS_OWNER_FLUSH, area->x1, area->x2, raset, rows,
+        px_map + (size_t)(y - area->y1) * row_bytes, rows * row_bytes);
+    if (ret != ESP_OK) {
+      ESP_LOGE(TAG, "RAM write failed: %s", esp_err_to_name(ret));
+      atomic_fetch_sub(&flush_trans_pending, 1);
+    }
+
+    y += rows;
+  }
+
+  xSemaphoreGive(bus_lock);
+  st7789_flush_done(disp);
+}
+
+static esp_err_t st7789_blit_impl(const lv_area_t *area,
+                                  const uint16_t *pixels) {
+  if (lcd_io == NULL || blit_buf == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  if (area->x1 < 0 || area->y1 < 0 || area->x2 >= driver_config.h_res ||
+      area->y2 >= driver_config.v_res) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  const int w = lv_area_get_width(area);
+  if (w > BLIT_BUF_PIXELS) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  const uint16_t max_rows = BLIT_BUF_PIXELS / w;
+
+  display_hal_flush_tap(area, pixels);
+
+  esp_err_t ret = ESP_OK;
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  st7789_update_color_depth();
+
+  int y = area->y1;
+  while (y <= area->y2 && ret == ESP_OK) {
+    uint16_t raset;
+    uint16_t rows = st7789_scroll_find_run(&scroll, y, area->y2, &raset);
+    if (rows > max_rows) {
+      rows = max_rows;
+    }
+
+    // Caller's pixels may live anywhere - copy into DMA memory
+    size_t count = (size_t)w * rows;
+    memcpy(blit_buf, pixels + (size_t)(y - area->y1) * w,
+           count * sizeof(uint16_t));
+
+    size_t len = count * sizeof(uint16_t);
+    if (color_12bit) {
+      if (driver_config.rgb444_dither) {
+        rgb444_pack_dither(blit_buf, (uint8_t *)blit_buf, w, rows, area->x1, y);
+      } else {
+        rgb444_pack(blit_buf, (uint8_t *)blit_buf, count);
+      }
+      len = RGB444_PACKED_SIZE(count);
+    }
+
+    ret = st7789_queue_write(TRANS_OWNER_BLIT, area->x1, area->x2, raset, rows,
+                             blit_buf, len);
+    if (ret == ESP_OK) {
+      xSemaphoreTake(blit_done, portMAX_DELAY); // Bounce buffer is reused
+    }
+
+    y += rows;
+  }
+
+  xSemaphoreGive(bus_lock);
+  return ret;
+}
+
+/**
+ * @brief Apply a pending scroll once the frame exposing new rows is sent
+ *
+ * tx_param waits for queued colour transfers, so the panel never shows the
+ * new start address before the exposed rows are written.
+ */
+static void st7789_refr_ready_cb(lv_event_t *e) {
+  if (scroll_start_pending) {
+    scroll_start_pending = false;
+    xSemaphoreTake(bus_lock, portMAX_DELAY);
+    st7789_scroll_send_start(&scroll, st7789_tx_param, NULL);
+    xSemaphoreGive(bus_lock);
+  }
+}
+
+/**
+ * @brief Keep areas 2-pixel aligned so RGB444 rows pack to whole bytes
+ */
+static void st7789_rounder_cb(lv_event_t *e) {
+  lv_area_t *area = lv_event_get_param(e);
+  area->x1 &= ~1;
+  area->x2 |= 1;
+  if (area->x2 >= driver_config.h_res) {
+    area->x2 = driver_config.h_res - 1;
+  }
+}
+
+static esp_err_t st7789_set_low_color_depth_impl(bool enable) {
+  if (lcd_io == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  color_12bit_requested = enable;
+  return ESP_OK;
+}
+
+static esp_err_t st7789_scroll_define_impl(uint16_t top, uint16_t height) {
+  if (lcd_io == NULL || bus_lock == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  if (top + height > driver_config.v_res) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (top == scroll.top && height == scroll.height) {
+    return ESP_OK;
+  }
+
+  // RAM of the old area is still rotated - LVGL must repaint it
+  if (scroll.height > 0 && scroll.offset != 0) {
+    lv_area_t old_area = {
+        .x1 = 0,
+        .y1 = scroll.top,
+        .x2 = driver_config.h_res - 1,
+        .y2 = scroll.top + scroll.height - 1,
+    };
+    lv_inv_area(lvgl_disp, &old_area);
+  }
+
+  scroll_start_pending = false;
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  esp_err_t ret =
+      st7789_scroll_define(&scroll, top, height, st7789_tx_param, NULL);
+  xSemaphoreGive(bus_lock);
+  return ret;
+}
+
+static esp_err_t st7789_scroll_impl(int16_t lines) {
+  if (scroll.height == 0) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  st7789_scroll_move(&scroll, lines);
+  scroll_start_pending = true;
+  return ESP_OK;
+}
+
+static esp_err_t st7789_set_idle_mode_impl(bool enable) {
+  if (lcd_io == NULL || bus_lock == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  esp_err_t ret = esp_lcd_panel_io_tx_param(
+      lcd_io, enable ? LCD_CMD_IDMON : LCD_CMD_IDMOFF, NULL, 0);
+  xSemaphoreGive(bus_lock);
+  return ret;
+}
+
+static esp_err_t st7789_set_partial_mode_impl(bool enable, uint16_t y_start,
+                                              uint16_t y_end) {
+  if (lcd_io == NULL || bus_lock == NULL) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  if (!enable) {
+    xSemaphoreTake(bus_lock, portMAX_DELAY);
+    esp_err_t ret = esp_lcd_panel_io_tx_param(lcd_io, LCD_CMD_NORON, NULL, 0);
+    xSemaphoreGive(bus_lock);
+    return ret;
+  }
+
+  if (y_end >= driver_config.v_res) {
+    y_end = driver_config.v_res - 1;
+  }
+
+  uint16_t first = st7789_scroll_row_to_line(&scroll, y_start);
+  uint16_t last = st7789_scroll_row_to_line(&scroll, y_end);
+  if (first > last) {
+    uint16_t tmp = first;
+    first = last;
+    last = tmp;
+  }
+
+  const uint8_t ptlar[] = {first >> 8, first & 0xFF, last >> 8, last & 0xFF};
+  xSemaphoreTake(bus_lock, portMAX_DELAY);
+  esp_err_t ret = esp_lcd_panel_io_tx_param(lcd_io, LCD_CMD_PTLAR, ptlar,
+                                            sizeof(ptlar));
+  if (ret == ESP_OK) {
+    ret = esp_lcd_panel_io_tx_param(lcd_io, LCD_CMD_PTLON, NULL, 0);
   }
+  xSemaphoreGive(bus_lock);
   return ret;
 }
 
@@ -201,8 +700,15 @@ static lv_display_t *st7789_get_lvgl_display_impl(void) { return lvgl_disp; }
 static const display_hal_interface_t st7789_interface = {
     .init = st7789_init_impl,
     .set_brightness = st7789_set_brightness_impl,
+    .fade_brightness = st7789_fade_brightness_impl,
     .sleep = st7789_sleep_impl,
     .wakeup = st7789_wakeup_impl,
+    .set_idle_mode = st7789_set_idle_mode_impl,
+    .set_partial_mode = st7789_set_partial_mode_impl,
+    .scroll_define = st7789_scroll_define_impl,
+    .scroll = st7789_scroll_impl,
+    .set_low_color_depth = st7789_set_low_color_depth_impl,
+    .blit = st7789_blit_impl,
     .get_lvgl_display = st7789_get_lvgl_display_impl,
     .name = "ST7789"};
 
@@ -18,6 +18,7 @@ typedef struct {
   gpio_num_t pin_cs;
   gpio_num_t pin_bl;
   spi_host_device_t spi_host;
+  bool rgb444_dither; // Ordered dithering for 12-bit animation frames
 } st7789_config_t;
 
 /**
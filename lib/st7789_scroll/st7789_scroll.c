@@ -0,0 +1,114 @@
+#include "st7789_scroll.h"
+
+void st7789_scroll_init(st7789_scroll_t *scroll, uint16_t x_gap,
+                        uint16_t y_gap, uint16_t ram_rows, bool mirror_y) {
+  *scroll = (st7789_scroll_t){
+      .x_gap = x_gap,
+      .y_gap = y_gap,
+      .ram_rows = ram_rows,
+      .mirror_y = mirror_y,
+  };
+}
+
+uint16_t st7789_scroll_row_to_line(const st7789_scroll_t *scroll,
+                                   uint16_t row) {
+  return scroll->mirror_y ? (scroll->ram_rows - 1 - scroll->y_gap - row)
+                          : (row + scroll->y_gap);
+}
+
+uint16_t st7789_scroll_row_to_raset(const st7789_scroll_t *scroll,
+                                    uint16_t row) {
+  if (scroll->height == 0 || row < scroll->top ||
+      row >= scroll->top + scroll->height) {
+    return row + scroll->y_gap;
+  }
+
+  uint16_t rel = (row - scroll->top + scroll->offset) % scroll->height;
+  return scroll->top + rel + scroll->y_gap;
+}
+
+uint16_t st7789_scroll_find_run(const st7789_scroll_t *scroll, int y,
+                                int y_end, uint16_t *raset) {
+  *raset = st7789_scroll_row_to_raset(scroll, y);
+  uint16_t rows = 1;
+  while (y + rows <= y_end &&
+         st7789_scroll_row_to_raset(scroll, y + rows) == *raset + rows) {
+    rows++;
+  }
+  return rows;
+}
+
+int st7789_scroll_send_window(const st7789_scroll_t *scroll, int x1, int x2,
+                              uint16_t raset, uint16_t rows,
+                              st7789_scroll_tx_t tx, void *ctx) {
+  const uint16_t xs = x1 + scroll->x_gap;
+  const uint16_t xe = x2 + scroll->x_gap;
+  const uint16_t ye = raset + rows - 1;
+  const uint8_t caset[] = {xs >> 8, xs & 0xFF, xe >> 8, xe & 0xFF};
+  const uint8_t raset_params[] = {raset >> 8, raset & 0xFF, ye >> 8,
+                                  ye & 0xFF};
+
+  int ret = tx(ctx, ST7789_CMD_CASET, caset, sizeof(caset));
+  if (ret != 0) return ret;
+  return tx(ctx, ST7789_CMD_RASET, raset_params, sizeof(raset_params));
+}
+
+/**
+ * @brief First display line of the area (mirroring reverses the rows)
+ */
+static uint16_t area_first_line(const st7789_scroll_t *scroll) {
+  uint16_t a = st7789_scroll_row_to_line(scroll, scroll->top);
+  uint16_t b =
+      st7789_scroll_row_to_line(scroll, scroll->top + scroll->height - 1);
+  return (a < b) ? a : b;
+}
+
+int st7789_scroll_define(st7789_scroll_t *scroll, uint16_t top,
+                         uint16_t height, st7789_scroll_tx_t tx, void *ctx) {
+  scroll->top = top;
+  scroll->height = height;
+  scroll->offset = 0;
+
+  uint16_t tfa = 0;
+  uint16_t vsa = scroll->ram_rows;
+  if (height > 0) {
+    tfa = area_first_line(scroll);
+    vsa = height;
+  }
+  uint16_t bfa = scroll->ram_rows - tfa - vsa;
+
+  const uint8_t vscrdef[] = {tfa >> 8, tfa & 0xFF, vsa >> 8,
+                             vsa & 0xFF, bfa >> 8, bfa & 0xFF};
+  int ret = tx(ctx, ST7789_CMD_VSCRDEF, vscrdef, sizeof(vscrdef));
+  if (ret != 0) {
+    return ret;
+  }
+  return st7789_scroll_send_start(scroll, tx, ctx);
+}
+
+void st7789_scroll_move(st7789_scroll_t *scroll, int16_t lines) {
+  if (scroll->height == 0) {
+    return;
+  }
+
+  int32_t offset = ((int32_t)scroll->offset - lines) % scroll->height;
+  if (offset < 0) {
+    offset += scroll->height;
+  }
+  scroll->offset = offset;
+}
+
+int st7789_scroll_send_start(const st7789_scroll_t *scroll,
+                             st7789_scroll_tx_t tx, void *ctx) {
+  uint16_t vsp = 0;
+  if (scroll->height > 0) {
+    // Mirrored rows scroll the opposite way in display-line space
+    vsp = area_first_line(scroll) +
+          (scroll->mirror_y
+               ? (scroll->height - scroll->offset) % scroll->height
+               : scroll->offset);
+  }
+
+  const uint8_t vscsad[] = {vsp >> 8, vsp & 0xFF};
+  return tx(ctx, ST7789_CMD_VSCSAD, vscsad, sizeof(vscsad));
+}
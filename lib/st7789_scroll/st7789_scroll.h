@@ -0,0 +1,93 @@
+#ifndef ST7789_SCROLL_H
+#define ST7789_SCROLL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief ST7789 RAM addressing and hardware vertical scroll
+ *
+ * The glass may sit in the middle of the controller RAM (y_gap) and MADCTL
+ * mirroring flips RAM writes but not the display-line addresses used by
+ * VSCRDEF/VSCSAD/PTLAR. This keeps that mapping in one place.
+ * Pure C with the bus behind a callback (host-testable).
+ */
+#define ST7789_CMD_CASET 0x2A
+#define ST7789_CMD_RASET 0x2B
+#define ST7789_CMD_VSCRDEF 0x33
+#define ST7789_CMD_VSCSAD 0x37
+
+/**
+ * @brief Send one command with its parameters, returns 0 on success
+ */
+typedef int (*st7789_scroll_tx_t)(void *ctx, uint8_t cmd,
+                                  const uint8_t *params, size_t len);
+
+/**
+ * @brief Panel geometry and scroll state (LVGL rows)
+ */
+typedef struct {
+  uint16_t x_gap;
+  uint16_t y_gap;    // First RAM row of the glass
+  uint16_t ram_rows; // Rows of controller RAM
+  bool mirror_y;     // MADCTL row mirroring
+  uint16_t top;      // Scroll area
+  uint16_t height;   // 0 = no scroll area
+  uint16_t offset;   // Content rotation inside the area
+} st7789_scroll_t;
+
+/**
+ * @brief Set the geometry, with no scroll area
+ */
+void st7789_scroll_init(st7789_scroll_t *scroll, uint16_t x_gap,
+                        uint16_t y_gap, uint16_t ram_rows, bool mirror_y);
+
+/**
+ * @brief Map an LVGL row to the controller's display line
+ */
+uint16_t st7789_scroll_row_to_line(const st7789_scroll_t *scroll,
+                                   uint16_t row);
+
+/**
+ * @brief Map an LVGL row to the RAM row (RASET address) currently shown there
+ */
+uint16_t st7789_scroll_row_to_raset(const st7789_scroll_t *scroll,
+                                    uint16_t row);
+
+/**
+ * @brief Count rows from y (up to y_end) that map to consecutive RAM rows
+ */
+uint16_t st7789_scroll_find_run(const st7789_scroll_t *scroll, int y,
+                                int y_end, uint16_t *raset);
+
+/**
+ * @brief Send CASET/RASET for a RAM write of rows rows from raset
+ */
+int st7789_scroll_send_window(const st7789_scroll_t *scroll, int x1, int x2,
+                              uint16_t raset, uint16_t rows,
+                              st7789_scroll_tx_t tx, void *ctx);
+
+/**
+ * @brief Define the scroll area and send VSCRDEF + VSCSAD
+ *
+ * height = 0 removes the area. The offset is reset.
+ */
+int st7789_scroll_define(st7789_scroll_t *scroll, uint16_t top,
+                         uint16_t height, st7789_scroll_tx_t tx, void *ctx);
+
+/**
+ * @brief Rotate the area content, positive lines move it down
+ *
+ * Only updates the RAM mapping; send VSCSAD once the exposed rows are
+ * written.
+ */
+void st7789_scroll_move(st7789_scroll_t *scroll, int16_t lines);
+
+/**
+ * @brief Send VSCSAD for the current offset
+ */
+int st7789_scroll_send_start(const st7789_scroll_t *scroll,
+                             st7789_scroll_tx_t tx, void *ctx);
+
+#endif // ST7789_SCROLL_H
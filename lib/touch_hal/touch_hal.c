@@ -55,6 +55,15 @@ SemaphoreHandle_t touch_hal_get_semaphore(void) {
   return touch_driver->get_semaphore();
 }
 
+esp_err_t touch_hal_set_notify(touch_hal_notify_cb_t cb, void *arg) {
+  if (touch_driver == NULL || touch_driver->set_notify == NULL) {
+    ESP_LOGE(TAG, "Touch driver not registered or doesn't support notify");
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  return touch_driver->set_notify(cb, arg);
+}
+
 const char *touch_hal_get_driver_name(void) {
   if (touch_driver == NULL) {
     return "none";
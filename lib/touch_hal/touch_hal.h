@@ -6,6 +6,11 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+/**
+ * @brief Touch activity notification (called from ISR context)
+ */
+typedef void (*touch_hal_notify_cb_t)(void *arg);
+
 /**
  * @brief Touch HAL interface
  */
@@ -14,6 +19,7 @@ typedef struct {
   esp_err_t (*deinit)(void);
   esp_lcd_touch_handle_t (*get_handle)(void);
   SemaphoreHandle_t (*get_semaphore)(void); // Для ISR callback
+  esp_err_t (*set_notify)(touch_hal_notify_cb_t cb, void *arg); // Optional
   const char *name;
 } touch_hal_interface_t;
 
@@ -42,6 +48,14 @@ esp_lcd_touch_handle_t touch_hal_get_handle(void);
  */
 SemaphoreHandle_t touch_hal_get_semaphore(void);
 
+/**
+ * @brief Register a callback run from the touch interrupt
+ *
+ * Lets the UI sleep until the controller reports activity instead of
+ * polling it.
+ */
+esp_err_t touch_hal_set_notify(touch_hal_notify_cb_t cb, void *arg);
+
 /**
  * @brief Get driver name
  */
@@ -5,6 +5,7 @@
 #include "driver/i2c_master.h"
 #include "driver/spi_common.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_lvgl_port.h"
 #include "pcf85063_driver.h"
 #include "rtc_hal.h"
@@ -45,6 +46,56 @@ static void board_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
   }
 }
 
+#ifdef LVGL_WAKEUP_STATS
+#define WAKEUP_STATS_PERIOD_US (10 * 1000 * 1000)
+#define WAKEUP_GAP_US 2000 // Reads closer than this are the same wakeup
+
+/**
+ * @brief Count LVGL task wakeups from the gaps between tick reads
+ *
+ * lv_timer_handler() reads the tick at least once per run, so a read
+ * after a quiet gap is a new wakeup. Logged every 10 s.
+ */
+static void board_count_wakeup(int64_t now_us) {
+  static int64_t last_read_us = 0;
+  static int64_t period_start_us = 0;
+  static uint32_t wakeups = 0;
+
+  if (now_us - last_read_us >= WAKEUP_GAP_US) {
+    wakeups++;
+  }
+  last_read_us = now_us;
+
+  if (now_us - period_start_us >= WAKEUP_STATS_PERIOD_US) {
+    ESP_LOGI(TAG, "LVGL task wakeups: %lu in %lu ms", (unsigned long)wakeups,
+             (unsigned long)((now_us - period_start_us) / 1000));
+    wakeups = 0;
+    period_start_us = now_us;
+  }
+}
+#endif
+
+/**
+ * @brief LVGL time base, read on demand instead of a periodic tick
+ */
+static uint32_t board_lvgl_tick_cb(void) {
+  int64_t now_us = esp_timer_get_time();
+#ifdef LVGL_WAKEUP_STATS
+  board_count_wakeup(now_us);
+#endif
+  return (uint32_t)(now_us / 1000);
+}
+
+/**
+ * @brief Touch interrupt - wake the LVGL task to read the new sample
+ *
+ * The indev read timer is paused while idle (see display_manager), so
+ * this is what starts input processing.
+ */
+static void board_touch_notify(void *arg) {
+  lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, arg);
+}
+
 esp_err_t board_init(void) {
   esp_err_t ret;
 
@@ -74,8 +125,8 @@ esp_err_t board_init(void) {
       .task_priority = 4,
       .task_stack = 8192, // Increased from 4096 - more code = more stack needed
       .task_affinity = -1,
-      .task_max_sleep_ms = 500,
-      .timer_period_ms = 5,
+      .task_max_sleep_ms = 2000, // Frame pacing wakes the task on demand
+      .timer_period_ms = 5,      // Required by the port, stopped below
   };
 
   ret = lvgl_port_init(&lvgl_cfg);
@@ -83,6 +134,18 @@ esp_err_t board_init(void) {
     ESP_LOGE(TAG, "Failed to init LVGL port");
     return ret;
   }
+
+  // Tickless: LVGL reads esp_timer when it needs the time, so the port's
+  // 5 ms tick timer (200 wakeups/s) is not needed. lvgl_port_stop() stops
+  // it but also disables LVGL timers, which are re-enabled right away;
+  // both touch LVGL state, so the port task must not run in between. The
+  // port task already sleeps until lv_timer_handler()'s next deadline.
+  lvgl_port_lock(-1);
+  lv_tick_set_cb(board_lvgl_tick_cb);
+  lvgl_port_stop();
+  lv_timer_enable(true);
+  lvgl_port_unlock();
+  ESP_LOGI(TAG, "LVGL tick on demand (periodic tick timer stopped)");
   ESP_LOGI(TAG, "LVGL port initialized");
 
   // Step 3: Initialize Display (ST7789)
@@ -103,6 +166,7 @@ esp_err_t board_init(void) {
       .pin_cs = ST7789_PIN_CS,
       .pin_bl = ST7789_PIN_BL,
       .spi_host = SPI2_HOST,
+      .rgb444_dither = ST7789_RGB444_DITHER,
   };
 
   ret = display_hal_init(&display_config);
@@ -156,6 +220,7 @@ esp_err_t board_init(void) {
   
   // Store globally
   touch_indev = indev;
+  touch_hal_set_notify(board_touch_notify, indev);
   
   ESP_LOGI(TAG, "LVGL touch input device created (indev=%p)", indev);
 
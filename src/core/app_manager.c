@@ -133,8 +133,20 @@ esp_err_t app_manager_show(app_id_t app_id, lv_scr_load_anim_t anim) {
     }
   }
 
-  // Switch screen
-  lv_screen_load_anim(apps[app_id].screen_obj, anim, 300, 0, false);
+  // Switch screen (immediately when not animated). Vertical slides use the
+  // panel's hardware scroll when available
+  uint32_t anim_time = (anim == LV_SCR_LOAD_ANIM_NONE) ? 0 : 300;
+  esp_err_t ret = ESP_ERR_NOT_SUPPORTED;
+  if (anim == LV_SCR_LOAD_ANIM_MOVE_TOP) {
+    ret = display_manager_scroll_transition(apps[app_id].screen_obj,
+                                            LV_DIR_TOP, anim_time);
+  } else if (anim == LV_SCR_LOAD_ANIM_MOVE_BOTTOM) {
+    ret = display_manager_scroll_transition(apps[app_id].screen_obj,
+                                            LV_DIR_BOTTOM, anim_time);
+  }
+  if (ret != ESP_OK) {
+    lv_screen_load_anim(apps[app_id].screen_obj, anim, anim_time, 0, false);
+  }
 
   // Update current
   current_app_id = app_id;
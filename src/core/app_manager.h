@@ -24,7 +24,7 @@ typedef struct {
   app_id_t id;
   app_type_t type;
   const char *name;
-  const lv_img_dsc_t *icon;
+  const void *icon; // LVGL image source, e.g. ASSET_SRC("..."), or NULL
   lv_obj_t *(*create)(void);
   void (*destroy)(lv_obj_t *screen);
   void (*on_show)(void);
@@ -1,13 +1,372 @@
 #include "display_manager.h"
+#include "core/event_manager.h"
 #include "display_hal.h"
 #include "esp_log.h"
+#include "esp_lvgl_port.h"
 
 static const char *TAG = "display_mgr";
 
+// Ambient (always-on) mode settings
+#ifndef DISPLAY_AMBIENT_TIMEOUT_MS
+#define DISPLAY_AMBIENT_TIMEOUT_MS 15000
+#endif
+#ifndef DISPLAY_AMBIENT_BRIGHTNESS
+#define DISPLAY_AMBIENT_BRIGHTNESS 24
+#endif
+
+// Backlight fade for dimming (full 0 -> 255 sweep)
+#define DISPLAY_DIM_FADE_MS 600
+
+// Refresh period while something moves (LV_DEF_REFR_PERIOD otherwise)
+#ifndef DISPLAY_REFR_ACTIVE_MS
+#define DISPLAY_REFR_ACTIVE_MS 16
+#endif
+
 static lv_display_t *lvgl_display = NULL;
 static lv_indev_t *touch_indev = NULL;
 static uint8_t current_brightness = 255;
 
+static bool ambient_active = false;
+static bool ambient_partial = false;
+static uint16_t ambient_y_start = 0;
+static uint16_t ambient_y_end = 0;
+static lv_timer_t *ambient_timer = NULL;
+
+/**
+ * @brief Hardware scroll area state
+ *
+ * The panel rotates the band itself; LVGL only redraws the rows exposed
+ * since the last refresh.
+ */
+static struct {
+  lv_obj_t *list;          // Scrollable object owning the band (NULL = none)
+  int32_t top;
+  int32_t height;
+  int32_t last_scroll_y;
+  int32_t exposed_top;     // Rows at the band top awaiting redraw
+  int32_t exposed_bottom;  // Rows at the band bottom awaiting redraw
+  bool scrolling;          // Filter invalidations inside the band
+  bool deferred_valid;     // Unrelated in-band changes, drawn at scroll end
+  lv_area_t deferred;
+} hw_scroll;
+
+static lv_obj_t *transition_screen = NULL;
+static int32_t transition_y = 0;
+
+// 12-bit panel writes while something moves
+static bool low_depth_active = false;
+static bool low_depth_supported = true;
+static bool low_depth_dirty_valid = false;
+static lv_area_t low_depth_dirty; // Drawn at low depth, redrawn afterwards
+
+static lv_timer_t *refr_timer = NULL;
+static lv_timer_t *indev_timer = NULL;
+
+/**
+ * @brief Inactivity timer - enters ambient mode once the user stops interacting
+ *
+ * Re-armed to the exact remaining time instead of polling.
+ */
+static void ambient_timer_cb(lv_timer_t *timer) {
+  uint32_t inactive = lv_display_get_inactive_time(lvgl_display);
+
+  if (inactive >= DISPLAY_AMBIENT_TIMEOUT_MS) {
+    display_manager_enter_ambient();
+    return;
+  }
+
+  lv_timer_set_period(timer, DISPLAY_AMBIENT_TIMEOUT_MS - inactive);
+}
+
+/**
+ * @brief Any touch leaves ambient mode
+ */
+static void ambient_touch_cb(lv_event_t *e) {
+  if (ambient_active) {
+    display_manager_exit_ambient();
+  }
+}
+
+/**
+ * @brief Rotate the band and invalidate only the rows it exposed
+ */
+static void hw_scroll_move(int32_t top, int32_t height, int32_t dy) {
+  if (dy == 0) {
+    return;
+  }
+
+  display_hal_scroll(dy);
+
+  // Strips queued earlier in this frame move with the content
+  if (dy > 0) {
+    hw_scroll.exposed_top = LV_MIN(height, hw_scroll.exposed_top + dy);
+    hw_scroll.exposed_bottom = LV_MAX(0, hw_scroll.exposed_bottom - dy);
+  } else {
+    hw_scroll.exposed_bottom = LV_MIN(height, hw_scroll.exposed_bottom - dy);
+    hw_scroll.exposed_top = LV_MAX(0, hw_scroll.exposed_top + dy);
+  }
+
+  bool filtering = hw_scroll.scrolling;
+  hw_scroll.scrolling = false;
+
+  lv_area_t strip = {
+      .x1 = 0,
+      .x2 = lv_display_get_horizontal_resolution(lvgl_display) - 1,
+  };
+  if (hw_scroll.exposed_top > 0) {
+    strip.y1 = top;
+    strip.y2 = top + hw_scroll.exposed_top - 1;
+    lv_inv_area(lvgl_display, &strip);
+  }
+  if (hw_scroll.exposed_bottom > 0) {
+    strip.y1 = top + height - hw_scroll.exposed_bottom;
+    strip.y2 = top + height - 1;
+    lv_inv_area(lvgl_display, &strip);
+  }
+
+  hw_scroll.scrolling = filtering;
+}
+
+/**
+ * @brief Keep LVGL from repainting the scrolled band while the panel moves it
+ *
+ * The list invalidates its whole area on every scroll step; that is dropped.
+ * Anything else inside the band is collected and drawn when scrolling ends.
+ */
+static void hw_scroll_invalidate_cb(lv_event_t *e) {
+  if (!hw_scroll.scrolling) {
+    return;
+  }
+
+  lv_area_t *area = lv_event_get_param(e);
+  int32_t band_y2 = hw_scroll.top + hw_scroll.height - 1;
+  if (area->y2 < hw_scroll.top || area->y1 > band_y2) {
+    return;
+  }
+
+  // Parts outside the band are still drawn normally
+  if (area->y1 < hw_scroll.top && area->y2 <= band_y2) {
+    area->y2 = hw_scroll.top - 1;
+    return;
+  }
+  if (area->y2 > band_y2 && area->y1 >= hw_scroll.top) {
+    area->y1 = band_y2 + 1;
+    return;
+  }
+  if (area->y1 < hw_scroll.top) {
+    return; // Spans the whole band
+  }
+
+  lv_area_t list_area;
+  lv_obj_get_coords(hw_scroll.list, &list_area);
+  if (!lv_area_is_in(area, &list_area, 0) || area->y1 != list_area.y1 ||
+      area->y2 != list_area.y2) {
+    if (hw_scroll.deferred_valid) {
+      lv_area_join(&hw_scroll.deferred, &hw_scroll.deferred, area);
+    } else {
+      hw_scroll.deferred = *area;
+      hw_scroll.deferred_valid = true;
+    }
+  }
+
+  // Must stay a valid area: replace with a row that is redrawn anyway
+  area->y1 = (hw_scroll.exposed_bottom > 0)
+                 ? band_y2 - hw_scroll.exposed_bottom + 1
+                 : hw_scroll.top;
+  area->y2 = area->y1;
+}
+
+static void hw_scroll_refr_ready_cb(lv_event_t *e) {
+  hw_scroll.exposed_top = 0;
+  hw_scroll.exposed_bottom = 0;
+}
+
+static void hw_scroll_list_event_cb(lv_event_t *e) {
+  lv_obj_t *list = lv_event_get_target(e);
+  lv_event_code_t code = lv_event_get_code(e);
+
+  if (code == LV_EVENT_SCROLL_BEGIN) {
+    // A hidden list (scrolled by a live insert) must not move the panel:
+    // nothing would repair the band under the active screen
+    if (transition_screen != NULL ||
+        lv_obj_get_screen(list) != lv_screen_active()) {
+      return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(list, &coords);
+    int32_t top = LV_MAX(coords.y1, 0);
+    int32_t bottom =
+        LV_MIN(coords.y2, lv_display_get_vertical_resolution(lvgl_display) - 1);
+    if (bottom <= top) {
+      return;
+    }
+
+    if (display_hal_scroll_define(top, bottom - top + 1) != ESP_OK) {
+      return;
+    }
+    hw_scroll.list = list;
+    hw_scroll.top = top;
+    hw_scroll.height = bottom - top + 1;
+    hw_scroll.last_scroll_y = lv_obj_get_scroll_y(list);
+    hw_scroll.deferred_valid = false;
+    hw_scroll.scrolling = true;
+  } else if (code == LV_EVENT_SCROLL) {
+    if (!hw_scroll.scrolling || hw_scroll.list != list) {
+      return;
+    }
+
+    int32_t scroll_y = lv_obj_get_scroll_y(list);
+    int32_t dy = hw_scroll.last_scroll_y - scroll_y;
+    hw_scroll.last_scroll_y = scroll_y;
+
+    if (LV_ABS(dy) >= hw_scroll.height) {
+      // Jumped a full page - nothing to reuse, so let the whole list
+      // through the invalidation filter
+      hw_scroll.scrolling = false;
+      lv_obj_invalidate(list);
+      hw_scroll.scrolling = true;
+      return;
+    }
+    hw_scroll_move(hw_scroll.top, hw_scroll.height, dy);
+  } else if (code == LV_EVENT_SCROLL_END || code == LV_EVENT_DELETE) {
+    if (hw_scroll.list != list) {
+      return;
+    }
+
+    hw_scroll.scrolling = false;
+    if (hw_scroll.deferred_valid) {
+      hw_scroll.deferred_valid = false;
+      lv_inv_area(lvgl_display, &hw_scroll.deferred);
+    }
+
+    // The band stays defined: the driver maps RAM rows transparently
+    if (code == LV_EVENT_DELETE) {
+      hw_scroll.list = NULL;
+      display_hal_scroll_define(0, 0);
+    }
+  }
+}
+
+static void scroll_transition_exec_cb(void *var, int32_t v) {
+  int32_t dy = v - transition_y;
+  transition_y = v;
+
+  // The panel moves what is already there; only the new rows are drawn
+  lv_display_enable_invalidation(lvgl_display, false);
+  lv_obj_set_y(var, v);
+  lv_display_enable_invalidation(lvgl_display, true);
+
+  hw_scroll_move(0, lv_display_get_vertical_resolution(lvgl_display), dy);
+}
+
+static void scroll_transition_completed_cb(lv_anim_t *a) {
+  transition_screen = NULL;
+  // Full-height rotation ends at offset 0: RAM is already in place
+  display_hal_scroll_define(0, 0);
+}
+
+/**
+ * @brief Check if content is moving (animation, scroll or slide)
+ */
+static bool display_animating(void) {
+  return lv_anim_count_running() > 0 || hw_scroll.scrolling ||
+         transition_screen != NULL;
+}
+
+static bool touch_pressed(void) {
+  return touch_indev != NULL &&
+         lv_indev_get_state(touch_indev) == LV_INDEV_STATE_PRESSED;
+}
+
+/**
+ * @brief Frame pacing - decide when the next refresh should run
+ *
+ * Runs after every refresh timer tick. Motion or touch keeps the fast
+ * period; otherwise the timer is paused until something is invalidated,
+ * so an idle screen causes no periodic wakeups at all.
+ */
+static void pacer_refr_ready_cb(lv_event_t *e) {
+  if (display_animating() || touch_pressed()) {
+    lv_timer_set_period(refr_timer, DISPLAY_REFR_ACTIVE_MS);
+  } else {
+    lv_timer_pause(refr_timer);
+  }
+}
+
+/**
+ * @brief Restart refreshing on the first invalidation after idle
+ *
+ * The paused timer is overdue, so the frame runs on the very next LVGL
+ * cycle; the task is woken in case the caller is another task.
+ */
+static void pacer_invalidate_cb(lv_event_t *e) {
+  if (!lv_timer_get_paused(refr_timer)) {
+    return;
+  }
+
+  lv_timer_set_period(refr_timer, (display_animating() || touch_pressed())
+                                      ? DISPLAY_REFR_ACTIVE_MS
+                                      : LV_DEF_REFR_PERIOD);
+  lv_timer_resume(refr_timer);
+  lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
+}
+
+/**
+ * @brief Poll touch only while a finger is down
+ *
+ * The first sample of a touch is read on the controller's interrupt.
+ */
+static void pacer_touch_cb(lv_event_t *e) {
+  if (lv_event_get_code(e) == LV_EVENT_PRESSED) {
+    lv_timer_resume(indev_timer);
+  } else {
+    lv_timer_pause(indev_timer);
+  }
+}
+
+/**
+ * @brief Pick the panel colour depth for the frame about to be rendered
+ *
+ * Motion frames go out as 12-bit; once things settle the areas touched at
+ * low depth are repainted at full depth.
+ */
+static void low_depth_refr_start_cb(lv_event_t *e) {
+  if (!low_depth_supported) {
+    return;
+  }
+
+  bool animating = display_animating();
+  if (animating == low_depth_active) {
+    return;
+  }
+
+  if (display_hal_set_low_color_depth(animating) != ESP_OK) {
+    low_depth_supported = false;
+    return;
+  }
+  low_depth_active = animating;
+
+  if (!animating && low_depth_dirty_valid) {
+    low_depth_dirty_valid = false;
+    lv_inv_area(lvgl_display, &low_depth_dirty);
+  }
+}
+
+static void low_depth_invalidate_cb(lv_event_t *e) {
+  if (!low_depth_active) {
+    return;
+  }
+
+  const lv_area_t *area = lv_event_get_param(e);
+  if (low_depth_dirty_valid) {
+    lv_area_join(&low_depth_dirty, &low_depth_dirty, area);
+  } else {
+    low_depth_dirty = *area;
+    low_depth_dirty_valid = true;
+  }
+}
+
 esp_err_t display_manager_init(lv_display_t *display, lv_indev_t *indev) {
   if (display == NULL) {
     ESP_LOGE(TAG, "Display is NULL");
@@ -17,6 +376,42 @@ esp_err_t display_manager_init(lv_display_t *display, lv_indev_t *indev) {
   lvgl_display = display;
   touch_indev = indev;
   current_brightness = 255;
+  ambient_active = false;
+  ambient_partial = false;
+
+  lvgl_port_lock(-1);
+  ambient_timer = lv_timer_create(ambient_timer_cb, DISPLAY_AMBIENT_TIMEOUT_MS, NULL);
+  if (indev != NULL) {
+    lv_indev_add_event_cb(indev, ambient_touch_cb, LV_EVENT_PRESSED, NULL);
+  }
+  lv_display_add_event_cb(display, hw_scroll_invalidate_cb,
+                          LV_EVENT_INVALIDATE_AREA, NULL);
+  lv_display_add_event_cb(display, hw_scroll_refr_ready_cb, LV_EVENT_REFR_READY,
+                          NULL);
+  lv_display_add_event_cb(display, low_depth_invalidate_cb,
+                          LV_EVENT_INVALIDATE_AREA, NULL);
+  lv_display_add_event_cb(display, low_depth_refr_start_cb, LV_EVENT_REFR_START,
+                          NULL);
+
+  // Frame pacing
+  refr_timer = lv_display_get_refr_timer(display);
+  lv_display_add_event_cb(display, pacer_invalidate_cb,
+                          LV_EVENT_INVALIDATE_AREA, NULL);
+  lv_display_add_event_cb(display, pacer_refr_ready_cb, LV_EVENT_REFR_READY,
+                          NULL);
+  lv_timer_set_period(lv_anim_get_timer(), DISPLAY_REFR_ACTIVE_MS);
+  if (indev != NULL) {
+    indev_timer = lv_indev_get_read_timer(indev);
+    lv_indev_add_event_cb(indev, pacer_touch_cb, LV_EVENT_PRESSED, NULL);
+    lv_indev_add_event_cb(indev, pacer_touch_cb, LV_EVENT_RELEASED, NULL);
+    lv_timer_pause(indev_timer);
+  }
+  lvgl_port_unlock();
+
+  if (ambient_timer == NULL) {
+    ESP_LOGE(TAG, "Failed to create ambient timer");
+    return ESP_ERR_NO_MEM;
+  }
   
   if (indev == NULL) {
     ESP_LOGI(TAG, "Display manager initialized (display=%p, touch disabled)", display);
@@ -28,6 +423,12 @@ esp_err_t display_manager_init(lv_display_t *display, lv_indev_t *indev) {
 }
 
 esp_err_t display_manager_set_brightness(uint8_t level) {
+  if (ambient_active) {
+    // Applied when leaving ambient mode
+    current_brightness = level;
+    return ESP_OK;
+  }
+
   esp_err_t ret = display_hal_set_brightness(level);
   if (ret == ESP_OK) {
     current_brightness = level;
@@ -47,9 +448,130 @@ esp_err_t display_manager_sleep(void) {
 
 esp_err_t display_manager_wakeup(void) {
   ESP_LOGI(TAG, "Display wakeup");
+  // The panel keeps its RAM while off, so the last frame comes back as is:
+  // there is no cached copy to restore
   return display_hal_wakeup();
 }
 
+void display_manager_set_ambient_area(bool enable, uint16_t y_start,
+                                      uint16_t y_end) {
+  ambient_partial = enable;
+  ambient_y_start = y_start;
+  ambient_y_end = y_end;
+}
+
+esp_err_t display_manager_enter_ambient(void) {
+  if (ambient_active) {
+    return ESP_OK;
+  }
+
+  ESP_LOGI(TAG, "Entering ambient mode");
+  ambient_active = true;
+  lv_timer_pause(ambient_timer);
+
+  // Let the UI switch to its reduced-palette variant and paint it before
+  // the panel drops to 8 colours
+  event_manager_emit_simple(EVENT_SYSTEM_AMBIENT_ENTER);
+  lv_refr_now(lvgl_display);
+
+  if (ambient_partial) {
+    display_hal_set_partial_mode(true, ambient_y_start, ambient_y_end);
+  }
+  display_hal_set_idle_mode(true);
+
+  return display_hal_fade_brightness(DISPLAY_AMBIENT_BRIGHTNESS, DISPLAY_DIM_FADE_MS);
+}
+
+esp_err_t display_manager_exit_ambient(void) {
+  if (!ambient_active) {
+    return ESP_OK;
+  }
+
+  ESP_LOGI(TAG, "Leaving ambient mode");
+  ambient_active = false;
+
+  display_hal_set_idle_mode(false);
+  if (ambient_partial) {
+    display_hal_set_partial_mode(false, 0, 0);
+  }
+
+  event_manager_emit_simple(EVENT_SYSTEM_AMBIENT_EXIT);
+
+  lv_timer_set_period(ambient_timer, DISPLAY_AMBIENT_TIMEOUT_MS);
+  lv_timer_reset(ambient_timer);
+  lv_timer_resume(ambient_timer);
+
+  return display_hal_fade_brightness(current_brightness, DISPLAY_DIM_FADE_MS);
+}
+
+bool display_manager_is_ambient(void) {
+  return ambient_active;
+}
+
+esp_err_t display_manager_scroll_transition(lv_obj_t *screen, lv_dir_t dir,
+                                            uint32_t time) {
+  if (screen == NULL || (dir != LV_DIR_TOP && dir != LV_DIR_BOTTOM)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  if (!display_hal_supports_scroll()) {
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+
+  // Finish an interrupted transition the slow way
+  if (transition_screen != NULL) {
+    lv_obj_t *previous = transition_screen;
+    lv_anim_delete(previous, scroll_transition_exec_cb);
+    transition_screen = NULL;
+    lv_obj_set_y(previous, 0);
+  }
+
+  int32_t ver_res = lv_display_get_vertical_resolution(lvgl_display);
+  hw_scroll.scrolling = false;
+  hw_scroll.list = NULL;
+  esp_err_t ret = display_hal_scroll_define(0, ver_res);
+  if (ret != ESP_OK) {
+    return ret;
+  }
+
+  // Panel RAM must match the outgoing screen before it starts moving
+  lv_refr_now(lvgl_display);
+
+  // Moving content towards the top brings the new screen in from below
+  transition_y = (dir == LV_DIR_TOP) ? ver_res : -ver_res;
+  transition_screen = screen;
+
+  lv_display_enable_invalidation(lvgl_display, false);
+  lv_obj_set_y(screen, transition_y);
+  lv_screen_load(screen);
+  lv_display_enable_invalidation(lvgl_display, true);
+
+  lv_anim_t a;
+  lv_anim_init(&a);
+  lv_anim_set_var(&a, screen);
+  lv_anim_set_values(&a, transition_y, 0);
+  lv_anim_set_duration(&a, time);
+  lv_anim_set_exec_cb(&a, scroll_transition_exec_cb);
+  lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+  lv_anim_set_completed_cb(&a, scroll_transition_completed_cb);
+  lv_anim_start(&a);
+
+  return ESP_OK;
+}
+
+void display_manager_attach_hw_scroll(lv_obj_t *obj) {
+  if (obj == NULL || !display_hal_supports_scroll()) {
+    return;
+  }
+
+  // Scrollbar would move with the content
+  lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+  lv_obj_add_event_cb(obj, hw_scroll_list_event_cb, LV_EVENT_SCROLL_BEGIN, NULL);
+  lv_obj_add_event_cb(obj, hw_scroll_list_event_cb, LV_EVENT_SCROLL, NULL);
+  lv_obj_add_event_cb(obj, hw_scroll_list_event_cb, LV_EVENT_SCROLL_END, NULL);
+  lv_obj_add_event_cb(obj, hw_scroll_list_event_cb, LV_EVENT_DELETE, NULL);
+}
+
 lv_display_t *display_manager_get_display(void) {
   return lvgl_display;
 }
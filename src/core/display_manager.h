@@ -29,6 +29,55 @@ esp_err_t display_manager_sleep(void);
  */
 esp_err_t display_manager_wakeup(void);
 
+/**
+ * @brief Set the rows kept visible in ambient mode
+ *
+ * With enable=false the whole panel stays on in ambient mode.
+ */
+void display_manager_set_ambient_area(bool enable, uint16_t y_start,
+                                      uint16_t y_end);
+
+/**
+ * @brief Enter low-power ambient mode (must hold the LVGL lock)
+ *
+ * Emits EVENT_SYSTEM_AMBIENT_ENTER, then switches the panel to idle
+ * (8-colour) and partial mode and dims the backlight. Entered automatically
+ * after a period without touch input.
+ */
+esp_err_t display_manager_enter_ambient(void);
+
+/**
+ * @brief Leave ambient mode (must hold the LVGL lock)
+ *
+ * Emits EVENT_SYSTEM_AMBIENT_EXIT and restores panel mode and brightness.
+ */
+esp_err_t display_manager_exit_ambient(void);
+
+/**
+ * @brief Check if ambient mode is active
+ */
+bool display_manager_is_ambient(void);
+
+/**
+ * @brief Load a screen with a vertical slide done by the panel's scroll
+ *
+ * Both screens move by rotating panel RAM, so each frame only redraws the
+ * rows that slide in. dir is the direction the content moves
+ * (LV_DIR_TOP brings the new screen in from below). Must hold the LVGL
+ * lock. Returns ESP_ERR_NOT_SUPPORTED if the driver can't scroll.
+ */
+esp_err_t display_manager_scroll_transition(lv_obj_t *screen, lv_dir_t dir,
+                                            uint32_t time);
+
+/**
+ * @brief Scroll a vertically scrollable object with the panel's scroll
+ *
+ * Only rows exposed by each scroll step are redrawn. The rows spanned by
+ * obj are rotated across the full panel width, so whatever is beside obj
+ * on those rows must be a plain background. Disables obj's scrollbar.
+ */
+void display_manager_attach_hw_scroll(lv_obj_t *obj);
+
 /**
  * @brief Get LVGL display handle
  */
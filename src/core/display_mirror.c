@@ -0,0 +1,358 @@
+#include "display_mirror.h"
+#include "display_hal.h"
+#include "driver/usb_serial_jtag.h"
+#include "esp_log.h"
+#include "esp_lvgl_port.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "rle565.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "display_mirror";
+
+#define MIRROR_BLOCK_PX 16        // Delta granularity (pixels per block)
+#define MIRROR_PACKET_MAX 4096    // Largest packet, header included
+#define MIRROR_QUEUE_BYTES 32768  // Pending packets (oldest dropped)
+#define MIRROR_TASK_STACK 3072
+#define MIRROR_TASK_PRIORITY 2    // Below LVGL
+#define MIRROR_WRITE_TIMEOUT_MS 100
+
+// Packet layout (little-endian):
+//   magic "FBM1" | type u8 | reserved u8 | seq u16 | time_ms u32 |
+//   x u16 | y u16 | w u16 | h u16 | len u16 | payload | fletcher16 u16
+#define MIRROR_HEADER_SIZE 22
+#define MIRROR_TRAILER_SIZE 2
+#define MIRROR_TYPE_RECT 1
+#define MIRROR_TYPE_FRAME 2
+
+static lv_display_t *mirror_display = NULL;
+static uint16_t hor_res = 0;
+static uint16_t ver_res = 0;
+static uint16_t blocks_per_row = 0;
+
+// Hash of every block as the host last saw it (0 = unknown)
+static uint32_t *block_hash = NULL;
+
+static SemaphoreHandle_t mirror_lock = NULL;
+static TaskHandle_t sender_task = NULL;
+static uint8_t *encode_buf = NULL; // Packet being built (tap context)
+static uint8_t *send_buf = NULL;   // Packet being sent (sender task)
+
+// Packet queue: byte ring of whole packets
+static uint8_t *queue = NULL;
+static size_t queue_head = 0;
+static size_t queue_tail = 0;
+static size_t queue_used = 0;
+
+static uint16_t packet_seq = 0;
+static bool frame_has_rects = false;
+static atomic_bool resync_pending = false;
+static atomic_bool keyframe_pending = false;
+static uint32_t dropped_packets = 0;
+
+static uint32_t block_hash_fnv(const uint16_t *px) {
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < MIRROR_BLOCK_PX; i++) {
+    h = (h ^ px[i]) * 16777619u;
+  }
+  return h | 1; // Never 0, which means unknown
+}
+
+static uint16_t fletcher16(const uint8_t *data, size_t len) {
+  uint16_t a = 0;
+  uint16_t b = 0;
+  for (size_t i = 0; i < len; i++) {
+    a = (a + data[i]) % 255;
+    b = (b + a) % 255;
+  }
+  return (b << 8) | a;
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+static inline uint16_t get_u16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+static void queue_read(size_t pos, uint8_t *dst, size_t len) {
+  size_t first = MIRROR_QUEUE_BYTES - pos;
+  if (first > len) {
+    first = len;
+  }
+  memcpy(dst, queue + pos, first);
+  memcpy(dst + first, queue, len - first);
+}
+
+static void queue_write(const uint8_t *src, size_t len) {
+  size_t first = MIRROR_QUEUE_BYTES - queue_head;
+  if (first > len) {
+    first = len;
+  }
+  memcpy(queue + queue_head, src, first);
+  memcpy(queue, src + first, len - first);
+  queue_head = (queue_head + len) % MIRROR_QUEUE_BYTES;
+  queue_used += len;
+}
+
+/**
+ * @brief The host's copy no longer matches the panel - send a full frame
+ *
+ * Later packets are delta-encoded against content the host may never
+ * get, so forgetting only the lost rectangle is not enough. The sender
+ * task repaints the screen once the queue has drained, at the host's
+ * pace.
+ */
+static void request_keyframe(void) {
+  atomic_store(&keyframe_pending, true);
+  if (sender_task != NULL) {
+    xTaskNotifyGive(sender_task);
+  }
+}
+
+/**
+ * @brief Hardware scroll moved rows on the panel without a flush
+ *
+ * Mirroring thus repaints after every scroll step, giving up the
+ * hardware scroll savings while it is enabled.
+ */
+static void mirror_scroll_tap(void) { request_keyframe(); }
+
+static void drop_oldest(void) {
+  uint8_t header[MIRROR_HEADER_SIZE];
+  queue_read(queue_tail, header, sizeof(header));
+
+  size_t len = MIRROR_HEADER_SIZE + get_u16(header + 20) + MIRROR_TRAILER_SIZE;
+  queue_tail = (queue_tail + len) % MIRROR_QUEUE_BYTES;
+  queue_used -= len;
+  dropped_packets++;
+  request_keyframe();
+}
+
+/**
+ * @brief Queue the packet in encode_buf (mirror_lock held)
+ */
+static void enqueue_packet(uint8_t type, const lv_area_t *rect,
+                           size_t payload_len) {
+  uint8_t *p = encode_buf;
+  memcpy(p, "FBM1", 4);
+  p[4] = type;
+  p[5] = 0;
+  put_u16(p + 6, packet_seq++);
+  uint32_t now = (uint32_t)(esp_timer_get_time() / 1000);
+  put_u16(p + 8, now & 0xFFFF);
+  put_u16(p + 10, now >> 16);
+  put_u16(p + 12, rect ? rect->x1 : 0);
+  put_u16(p + 14, rect ? rect->y1 : 0);
+  put_u16(p + 16, rect ? lv_area_get_width(rect) : 0);
+  put_u16(p + 18, rect ? lv_area_get_height(rect) : 0);
+  put_u16(p + 20, payload_len);
+
+  size_t len = MIRROR_HEADER_SIZE + payload_len;
+  put_u16(p + len, fletcher16(p + 4, len - 4));
+  len += MIRROR_TRAILER_SIZE;
+
+  while (queue_used + len > MIRROR_QUEUE_BYTES) {
+    drop_oldest();
+  }
+  queue_write(p, len);
+
+  xTaskNotifyGive(sender_task);
+}
+
+/**
+ * @brief Encode one row, skipping blocks the host already has
+ */
+static size_t encode_row(const uint16_t *row, int x1, int x2, int y,
+                         uint8_t *out, size_t cap) {
+  rle565_skip_t skips[16];
+  size_t skip_count = 0;
+  uint32_t *hashes = block_hash + (size_t)y * blocks_per_row;
+
+  for (int b = x1 / MIRROR_BLOCK_PX; b <= x2 / MIRROR_BLOCK_PX; b++) {
+    int bx = b * MIRROR_BLOCK_PX;
+    if (bx < x1 || bx + MIRROR_BLOCK_PX - 1 > x2) {
+      hashes[b] = 0; // Partly rewritten - whole-block hash is stale
+      continue;
+    }
+
+    uint32_t h = block_hash_fnv(row + (bx - x1));
+    if (h == hashes[b]) {
+      uint16_t start = bx - x1;
+      if (skip_count > 0 &&
+          skips[skip_count - 1].start + skips[skip_count - 1].len == start) {
+        skips[skip_count - 1].len += MIRROR_BLOCK_PX;
+      } else if (skip_count < 16) {
+        skips[skip_count].start = start;
+        skips[skip_count].len = MIRROR_BLOCK_PX;
+        skip_count++;
+      }
+    }
+    hashes[b] = h;
+  }
+
+  return rle565_encode(row, x2 - x1 + 1, skips, skip_count, out, cap);
+}
+
+/**
+ * @brief Flush tap - encode the rectangle as a series of packets
+ */
+static void mirror_flush_tap(const lv_area_t *area, const uint16_t *pixels) {
+  const int w = lv_area_get_width(area);
+  const size_t row_max = RLE565_MAX_ENCODED_SIZE(w);
+  const size_t payload_cap = MIRROR_PACKET_MAX - MIRROR_HEADER_SIZE -
+                             MIRROR_TRAILER_SIZE;
+
+  xSemaphoreTake(mirror_lock, portMAX_DELAY);
+
+  if (atomic_exchange(&resync_pending, false)) {
+    memset(block_hash, 0,
+           (size_t)ver_res * blocks_per_row * sizeof(uint32_t));
+  }
+
+  lv_area_t band = *area;
+  size_t payload_len = 0;
+  for (int y = area->y1; y <= area->y2; y++) {
+    if (payload_len + row_max > payload_cap) {
+      band.y2 = y - 1;
+      enqueue_packet(MIRROR_TYPE_RECT, &band, payload_len);
+      band.y1 = y;
+      payload_len = 0;
+    }
+
+    payload_len += encode_row(pixels + (size_t)(y - area->y1) * w, area->x1,
+                              area->x2, y,
+                              encode_buf + MIRROR_HEADER_SIZE + payload_len,
+                              payload_cap - payload_len);
+  }
+  band.y2 = area->y2;
+  enqueue_packet(MIRROR_TYPE_RECT, &band, payload_len);
+  frame_has_rects = true;
+
+  xSemaphoreGive(mirror_lock);
+}
+
+static void mirror_refr_ready_cb(lv_event_t *e) {
+  xSemaphoreTake(mirror_lock, portMAX_DELAY);
+  if (frame_has_rects) {
+    frame_has_rects = false;
+    enqueue_packet(MIRROR_TYPE_FRAME, NULL, 0);
+  }
+  xSemaphoreGive(mirror_lock);
+}
+
+static void mirror_sender_task(void *arg) {
+  uint32_t reported_drops = 0;
+  bool host_ok = true; // Last write went through
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(200));
+
+    // Host asks for a keyframe
+    uint8_t rx;
+    if (usb_serial_jtag_read_bytes(&rx, 1, 0) == 1 && rx == 'R') {
+      display_mirror_resync();
+    }
+
+    while (1) {
+      size_t len = 0;
+      xSemaphoreTake(mirror_lock, portMAX_DELAY);
+      if (queue_used > 0) {
+        uint8_t header[MIRROR_HEADER_SIZE];
+        queue_read(queue_tail, header, sizeof(header));
+        len = MIRROR_HEADER_SIZE + get_u16(header + 20) + MIRROR_TRAILER_SIZE;
+        queue_read(queue_tail, send_buf, len);
+        queue_tail = (queue_tail + len) % MIRROR_QUEUE_BYTES;
+        queue_used -= len;
+      }
+      uint32_t drops = dropped_packets;
+      xSemaphoreGive(mirror_lock);
+
+      if (drops != reported_drops) {
+        ESP_LOGD(TAG, "%lu packets dropped", (unsigned long)drops);
+        reported_drops = drops;
+      }
+
+      if (len == 0) {
+        break;
+      }
+
+      int sent = usb_serial_jtag_write_bytes(send_buf, len,
+                                             pdMS_TO_TICKS(MIRROR_WRITE_TIMEOUT_MS));
+      host_ok = (sent == (int)len);
+      if (!host_ok) {
+        request_keyframe(); // Host is missing data
+      }
+    }
+
+    // Queue drained. No repaints while nobody reads: the next packet
+    // that gets through triggers the keyframe.
+    if (host_ok && atomic_exchange(&keyframe_pending, false)) {
+      display_mirror_resync();
+    }
+  }
+}
+
+void display_mirror_resync(void) {
+  atomic_store(&resync_pending, true);
+  if (mirror_display != NULL) {
+    lvgl_port_lock(-1);
+    lv_obj_invalidate(lv_display_get_screen_active(mirror_display));
+    lvgl_port_unlock();
+  }
+}
+
+esp_err_t display_mirror_init(lv_display_t *display) {
+  if (display == NULL) {
+    ESP_LOGE(TAG, "Display is NULL");
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  hor_res = lv_display_get_horizontal_resolution(display);
+  ver_res = lv_display_get_vertical_resolution(display);
+  blocks_per_row = (hor_res + MIRROR_BLOCK_PX - 1) / MIRROR_BLOCK_PX;
+
+  if (!usb_serial_jtag_is_driver_installed()) {
+    usb_serial_jtag_driver_config_t usj_cfg = {
+        .tx_buffer_size = MIRROR_PACKET_MAX,
+        .rx_buffer_size = 64,
+    };
+    esp_err_t ret = usb_serial_jtag_driver_install(&usj_cfg);
+    if (ret != ESP_OK) {
+      ESP_LOGE(TAG, "Failed to install USB Serial/JTAG driver");
+      return ret;
+    }
+  }
+
+  block_hash = calloc((size_t)ver_res * blocks_per_row, sizeof(uint32_t));
+  encode_buf = malloc(MIRROR_PACKET_MAX);
+  send_buf = malloc(MIRROR_PACKET_MAX);
+  queue = malloc(MIRROR_QUEUE_BYTES);
+  mirror_lock = xSemaphoreCreateMutex();
+  if (block_hash == NULL || encode_buf == NULL || send_buf == NULL ||
+      queue == NULL || mirror_lock == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate mirror buffers");
+    return ESP_ERR_NO_MEM;
+  }
+
+  if (xTaskCreate(mirror_sender_task, "fb_mirror", MIRROR_TASK_STACK, NULL,
+                  MIRROR_TASK_PRIORITY, &sender_task) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create sender task");
+    return ESP_ERR_NO_MEM;
+  }
+
+  mirror_display = display;
+  lvgl_port_lock(-1);
+  lv_display_add_event_cb(display, mirror_refr_ready_cb, LV_EVENT_REFR_READY,
+                          NULL);
+  lvgl_port_unlock();
+  display_hal_add_flush_tap(mirror_flush_tap);
+  display_hal_set_scroll_tap(mirror_scroll_tap);
+
+  ESP_LOGI(TAG, "Framebuffer mirror streaming over USB Serial/JTAG");
+  return ESP_OK;
+}
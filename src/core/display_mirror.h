@@ -0,0 +1,27 @@
+#ifndef DISPLAY_MIRROR_H
+#define DISPLAY_MIRROR_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+/**
+ * @brief Stream panel updates over the USB Serial/JTAG port
+ *
+ * Every rectangle written to the panel is sent as a delta/RLE packet
+ * (unchanged 16-pixel blocks are skipped), followed by a frame marker at
+ * the end of each LVGL refresh. Packets go through a bounded queue that
+ * drops the oldest entries, so a slow or absent host never stalls
+ * rendering. A drop, a failed write or a hardware scroll step is followed
+ * by a full-screen keyframe without deltas. Decode on the host with
+ * tools/fb_mirror.py, which sends 'R' to request a full repaint.
+ *
+ * Enabled at build time with -D DISPLAY_MIRROR.
+ */
+esp_err_t display_mirror_init(lv_display_t *display);
+
+/**
+ * @brief Forget what the host has and repaint the whole screen
+ */
+void display_mirror_resync(void);
+
+#endif // DISPLAY_MIRROR_H
@@ -93,21 +93,25 @@ esp_err_t event_manager_emit(event_type_t event_type, void *data,
     return ESP_ERR_INVALID_ARG;
   }
 
-  xSemaphoreTake(event_mutex, portMAX_DELAY);
-
-  event_t event = {.type = event_type, .data = data, .data_size = data_size};
-
+  // Snapshot subscribers so callbacks run without the mutex held and may
+  // themselves subscribe/unsubscribe (e.g. an app shown from a callback)
+  subscriber_t active[MAX_SUBSCRIBERS_PER_EVENT];
   int callback_count = 0;
+
+  xSemaphoreTake(event_mutex, portMAX_DELAY);
   for (int i = 0; i < MAX_SUBSCRIBERS_PER_EVENT; i++) {
     if (subscribers[event_type][i].active) {
-      subscribers[event_type][i].callback(&event,
-                                          subscribers[event_type][i].user_data);
-      callback_count++;
+      active[callback_count++] = subscribers[event_type][i];
     }
   }
-
   xSemaphoreGive(event_mutex);
 
+  event_t event = {.type = event_type, .data = data, .data_size = data_size};
+
+  for (int i = 0; i < callback_count; i++) {
+    active[i].callback(&event, active[i].user_data);
+  }
+
   if (callback_count > 0) {
     ESP_LOGD(TAG, "Event %d emitted to %d subscribers", event_type,
              callback_count);
@@ -25,11 +25,13 @@ typedef enum {
 
   // Notification events
   EVENT_NOTIFICATION_NEW,   // New notification arrived
-  EVENT_NOTIFICATION_CLEAR, // Notification cleared
+  EVENT_NOTIFICATION_CLEAR, // data: notification_clear_t* (NULL = all)
 
   // System events
   EVENT_SYSTEM_SLEEP,
   EVENT_SYSTEM_WAKEUP,
+  EVENT_SYSTEM_AMBIENT_ENTER, // Low-power always-on mode entered
+  EVENT_SYSTEM_AMBIENT_EXIT,  // Back to interactive mode
 
   EVENT_MAX
 } event_type_t;
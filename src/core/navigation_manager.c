@@ -1,13 +1,36 @@
 #include "navigation_manager.h"
 #include "app_manager.h"
+#include "core/event_manager.h"
 #include "esp_log.h"
+#include "esp_lvgl_port.h"
 
 static const char *TAG = "nav_manager";
 
 static nav_context_t current_context = NAV_CONTEXT_WATCHFACE;
 
+/**
+ * @brief Ambient mode always shows the watchface
+ */
+static void ambient_event_callback(const event_t *event, void *user_data) {
+  if (event->type == EVENT_SYSTEM_AMBIENT_ENTER &&
+      current_context != NAV_CONTEXT_WATCHFACE) {
+    ESP_LOGI(TAG, "Ambient mode - returning to watchface");
+    lvgl_port_lock(-1);
+    app_manager_show(APP_WATCHFACE, LV_SCR_LOAD_ANIM_NONE);
+    lvgl_port_unlock();
+  }
+}
+
 esp_err_t navigation_manager_init(void) {
   current_context = NAV_CONTEXT_WATCHFACE;
+
+  esp_err_t ret = event_manager_subscribe(EVENT_SYSTEM_AMBIENT_ENTER,
+                                          ambient_event_callback, NULL);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to subscribe to events: %s", esp_err_to_name(ret));
+    return ret;
+  }
+
   ESP_LOGI(TAG, "Navigation manager initialized");
   return ESP_OK;
 }
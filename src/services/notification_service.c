@@ -12,6 +12,7 @@ static const char *TAG = "notification_service";
  */
 static notification_t notifications[MAX_NOTIFICATIONS];
 static uint32_t notification_count = 0;
+static uint32_t generation = 0;
 
 /**
  * @brief Event callback - saves notifications to history
@@ -38,6 +39,7 @@ static void notification_event_callback(const event_t *event, void *user_data) {
       // Insert new notification at index 0
       memcpy(&notifications[0], notif, sizeof(notification_t));
     }
+    generation++;
 
     ESP_LOGI(TAG, "Notification saved: '%s' from '%s' (total: %d)",
              notif->title, notif->app_name, notification_count);
@@ -80,6 +82,8 @@ esp_err_t notification_service_init(void) {
 
 uint32_t notification_service_get_count(void) { return notification_count; }
 
+uint32_t notification_service_get_generation(void) { return generation; }
+
 const notification_t *notification_service_get_all(uint32_t *out_count) {
   if (out_count == NULL) {
     ESP_LOGE(TAG, "out_count is NULL");
@@ -95,6 +99,7 @@ const notification_t *notification_service_get_all(uint32_t *out_count) {
 esp_err_t notification_service_clear_all(void) {
   notification_count = 0;
   memset(notifications, 0, sizeof(notifications));
+  generation++;
 
   ESP_LOGI(TAG, "All notifications cleared");
 
@@ -113,9 +118,11 @@ esp_err_t notification_service_clear(uint32_t id) {
                 sizeof(notification_t) * (notification_count - i - 1));
       }
       notification_count--;
+      generation++;
 
       ESP_LOGI(TAG, "Notification %d cleared", id);
-      event_manager_emit_simple(EVENT_NOTIFICATION_CLEAR);
+      notification_clear_t clear = {.id = id, .index = i};
+      event_manager_emit(EVENT_NOTIFICATION_CLEAR, &clear, sizeof(clear));
       return ESP_OK;
     }
   }
@@ -26,6 +26,14 @@ typedef struct {
   uint32_t timestamp; // Unix timestamp
 } notification_t;
 
+/**
+ * @brief EVENT_NOTIFICATION_CLEAR data (NULL when all were cleared)
+ */
+typedef struct {
+  uint32_t id;
+  uint32_t index; // Position it had in the history (0 = newest)
+} notification_clear_t;
+
 /**
  * @brief Initialize notification service
  *
@@ -44,7 +52,7 @@ uint32_t notification_service_get_count(void);
  * @brief Get all notifications
  *
  * Returns pointer to internal notification array (read-only).
- * Array is ordered: most recent notification at the END (index = count - 1)
+ * Array is ordered: most recent notification first (index 0)
  *
  * @param out_count Output: number of notifications
  * @return const notification_t* Pointer to notification array (read-only, do
@@ -52,10 +60,18 @@ uint32_t notification_service_get_count(void);
  */
 const notification_t *notification_service_get_all(uint32_t *out_count);
 
+/**
+ * @brief Get the history generation
+ *
+ * Changes whenever a notification is added or cleared, so a view that
+ * recorded it can tell whether it is still up to date.
+ */
+uint32_t notification_service_get_generation(void);
+
 /**
  * @brief Clear all notifications
  *
- * Emits EVENT_NOTIFICATION_CLEAR
+ * Emits EVENT_NOTIFICATION_CLEAR with no data
  *
  * @return esp_err_t ESP_OK on success
  */
@@ -64,6 +80,8 @@ esp_err_t notification_service_clear_all(void);
 /**
  * @brief Clear specific notification by ID
  *
+ * Emits EVENT_NOTIFICATION_CLEAR with a notification_clear_t
+ *
  * @param id Notification ID
  * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if not found
  */
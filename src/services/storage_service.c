@@ -0,0 +1,36 @@
+#include "services/storage_service.h"
+#include "esp_log.h"
+#include "esp_vfs_fat.h"
+#include "wear_levelling.h"
+
+static const char *TAG = "storage_service";
+
+#define STORAGE_PARTITION "ffat"
+
+static wl_handle_t wl_handle = WL_INVALID_HANDLE;
+
+esp_err_t storage_service_init(void) {
+  const esp_vfs_fat_mount_config_t mount_config = {
+      .max_files = 4,
+      .format_if_mount_failed = true,
+      .allocation_unit_size = CONFIG_WL_SECTOR_SIZE,
+  };
+
+  esp_err_t ret = esp_vfs_fat_spiflash_mount_rw_wl(
+      STORAGE_BASE_PATH, STORAGE_PARTITION, &mount_config, &wl_handle);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to mount %s: %s", STORAGE_PARTITION,
+             esp_err_to_name(ret));
+    wl_handle = WL_INVALID_HANDLE;
+    return ret;
+  }
+
+  uint64_t total = 0;
+  uint64_t free_bytes = 0;
+  esp_vfs_fat_info(STORAGE_BASE_PATH, &total, &free_bytes);
+  ESP_LOGI(TAG, "Storage mounted at %s (%llu KB free of %llu KB)",
+           STORAGE_BASE_PATH, free_bytes / 1024, total / 1024);
+  return ESP_OK;
+}
+
+bool storage_service_is_mounted(void) { return wl_handle != WL_INVALID_HANDLE; }
@@ -0,0 +1,21 @@
+#ifndef STORAGE_SERVICE_H
+#define STORAGE_SERVICE_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+
+#define STORAGE_BASE_PATH "/ffat"
+
+/**
+ * @brief Mount the ffat partition at STORAGE_BASE_PATH
+ *
+ * The partition is formatted on first use.
+ */
+esp_err_t storage_service_init(void);
+
+/**
+ * @brief Check if the partition is mounted
+ */
+bool storage_service_is_mounted(void);
+
+#endif // STORAGE_SERVICE_H
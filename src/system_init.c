@@ -2,12 +2,14 @@
 #include "board_init.h"
 #include "core/app_manager.h"
 #include "core/display_manager.h"
+#include "core/display_mirror.h"
 #include "core/event_manager.h"
 #include "core/navigation_manager.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
 #include "services/battery_service.h"
 #include "services/steps_service.h"
+#include "services/storage_service.h"
 #include "services/notification_service.h"
 #include "services/time_service.h"
 #include "ui/apps/system_info_app.h"
@@ -16,6 +18,8 @@
 #include "ui/apps/notifications_app.h"
 #include "ui/apps/quick_access_app.h"
 #include "ui/apps/watchface_app.h"
+#include "ui/asset_pack.h"
+#include "ui/widgets/notification_toast.h"
 
 static const char *TAG = "system_init";
 
@@ -49,6 +53,13 @@ esp_err_t system_init(lv_display_t *display) {
     return ret;
   }
 
+#ifdef DISPLAY_MIRROR
+  // Debug aid only - keep booting without it
+  if (display_mirror_init(display) != ESP_OK) {
+    ESP_LOGW(TAG, "Framebuffer mirror unavailable");
+  }
+#endif
+
   ret = navigation_manager_init();
   if (ret != ESP_OK) {
     ESP_LOGE(TAG, "Failed to init navigation manager");
@@ -66,6 +77,11 @@ esp_err_t system_init(lv_display_t *display) {
   // Step 2: Services
   ESP_LOGI(TAG, "[2/4] Initializing services...");
 
+  // Optional: fonts and assets on ffat fall back to the built-in ones
+  if (storage_service_init() != ESP_OK) {
+    ESP_LOGW(TAG, "Storage unavailable");
+  }
+
   ret = time_service_init();
   if (ret != ESP_OK) {
     ESP_LOGE(TAG, "Failed to init time service");
@@ -100,6 +116,11 @@ esp_err_t system_init(lv_display_t *display) {
     return ESP_ERR_TIMEOUT;
   }
 
+  // Optional: apps fall back to text and shapes without images
+  if (asset_pack_init() != ESP_OK) {
+    ESP_LOGW(TAG, "Asset pack unavailable");
+  }
+
   ret = app_manager_register(watchface_app_get_descriptor());
   if (ret != ESP_OK) {
     lvgl_port_unlock();
@@ -146,6 +167,10 @@ esp_err_t system_init(lv_display_t *display) {
 
   ESP_LOGI(TAG, "All apps registered (6 total)");
 
+  if (notification_toast_init() != ESP_OK) {
+    ESP_LOGW(TAG, "Notification toasts unavailable");
+  }
+
   ESP_LOGI(TAG, "=== System Initialization Complete ===");
   return ESP_OK;
 }
@@ -8,12 +8,11 @@ static const char *TAG = "control_center_app";
 
 static lv_obj_t *control_center_app_create(void) {
   lv_obj_t *screen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(screen, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(screen, &theme_style_screen_dark, 0);
 
   lv_obj_t *label = lv_label_create(screen);
   lv_label_set_text(label, "Control Center\n(Coming Soon)");
-  lv_obj_set_style_text_color(label, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+  lv_obj_add_style(label, &theme_style_caption_light, 0);
   lv_obj_center(label);
 
   ESP_LOGI(TAG, "Control center screen created");
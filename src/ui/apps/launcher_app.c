@@ -1,21 +1,162 @@
 #include "ui/apps/launcher_app.h"
 #include "core/app_manager.h"
+#include "core/display_manager.h"
 #include "core/navigation_manager.h"
 #include "esp_log.h"
 #include "lvgl.h"
+#include "ui/asset_pack.h"
 #include "ui/theme.h"
+#include "ui/widgets/virtual_list.h"
 
 static const char *TAG = "launcher_app";
 
+#define ICON_ATLAS ASSET_SRC("app_icons")
+#define GRID_COLUMNS 2
+#define CELL_SIZE 80
+#define CELL_GAP 15
+#define ICON_SIZE 40
+
+// The grid is built from the registry when shown: user apps register
+// after the launcher's persistent screen is created
+static lv_obj_t *app_grid = NULL;
+static const app_descriptor_t **user_apps = NULL;
+static size_t user_app_count = 0;
+
 /**
  * @brief App icon click callback
  */
 static void app_icon_clicked(lv_event_t *e) {
-  app_id_t app_id = (app_id_t)(intptr_t)lv_event_get_user_data(e);
-  ESP_LOGI(TAG, "App clicked: %d", app_id);
+  const app_descriptor_t *app = lv_obj_get_user_data(lv_event_get_target(e));
+  if (app == NULL) {
+    return;
+  }
+  ESP_LOGI(TAG, "App clicked: %s", app->name);
 
   // Show app
-  app_manager_show(app_id, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+  app_manager_show(app->id, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+}
+
+/**
+ * @brief Draw the bound app's icon, from the atlas when it is packed there
+ */
+static void app_icon_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  const app_descriptor_t *app = lv_obj_get_user_data(obj);
+  if (app == NULL) {
+    return;
+  }
+
+  lv_area_t region;
+  const void *src = ICON_ATLAS;
+  if (!asset_pack_get_region(app->icon, ICON_ATLAS, &region)) {
+    if (!asset_pack_has(app->icon)) {
+      return;
+    }
+    src = app->icon; // A standalone image is its own region
+  }
+
+  lv_image_header_t header;
+  if (lv_image_decoder_get_info(src, &header) != LV_RESULT_OK) {
+    return;
+  }
+  if (src != ICON_ATLAS) {
+    lv_area_set(&region, 0, 0, header.w - 1, header.h - 1);
+  }
+
+  // Center the region in the icon box. Every atlas icon is a sub-rect of
+  // the same texture: image_area places the whole image so the region
+  // lands in the cell and coords clip it to the cell (LVGL only honours
+  // image_area's position when tiling; the one tile covers the cell)
+  lv_layer_t *layer = lv_event_get_layer(e);
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_area_t cell;
+  cell.x1 = coords.x1 + (ICON_SIZE - lv_area_get_width(&region)) / 2;
+  cell.y1 = coords.y1 + (ICON_SIZE - lv_area_get_height(&region)) / 2;
+  cell.x2 = cell.x1 + lv_area_get_width(&region) - 1;
+  cell.y2 = cell.y1 + lv_area_get_height(&region) - 1;
+
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+  dsc.src = src;
+  dsc.tile = 1;
+  lv_area_set(&dsc.image_area, 0, 0, header.w - 1, header.h - 1);
+  lv_area_move(&dsc.image_area, cell.x1 - region.x1, cell.y1 - region.y1);
+  lv_draw_image(layer, &dsc, &cell);
+}
+
+/**
+ * @brief Create one grid row of empty app cells
+ */
+static lv_obj_t *create_app_row(lv_obj_t *list, void *user_data) {
+  int32_t row_width = GRID_COLUMNS * CELL_SIZE + (GRID_COLUMNS - 1) * CELL_GAP;
+  lv_obj_t *row = lv_obj_create(list);
+  lv_obj_remove_style_all(row);
+  lv_obj_set_size(row, row_width, CELL_SIZE);
+  lv_obj_set_x(row, (lv_obj_get_content_width(list) - row_width) / 2);
+  lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+  for (int col = 0; col < GRID_COLUMNS; col++) {
+    lv_obj_t *btn = lv_btn_create(row);
+    lv_obj_set_size(btn, CELL_SIZE, CELL_SIZE);
+    lv_obj_set_x(btn, col * (CELL_SIZE + CELL_GAP));
+    lv_obj_add_style(btn, &theme_style_button, 0);
+    lv_obj_add_event_cb(btn, app_icon_clicked, LV_EVENT_CLICKED, NULL);
+
+    // Icon, drawn from the atlas
+    lv_obj_t *icon = lv_obj_create(btn);
+    lv_obj_remove_style_all(icon);
+    lv_obj_set_size(icon, ICON_SIZE, ICON_SIZE);
+    lv_obj_align(icon, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_clear_flag(icon, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(icon, app_icon_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    // App label
+    lv_obj_t *label = lv_label_create(btn);
+    lv_obj_add_style(label, &theme_style_caption_light, 0);
+    lv_obj_set_width(label, lv_pct(100));
+  }
+  return row;
+}
+
+/**
+ * @brief Bind grid row index to the apps it shows
+ */
+static void bind_app_row(lv_obj_t *row, uint32_t index, void *user_data) {
+  for (int col = 0; col < GRID_COLUMNS; col++) {
+    lv_obj_t *btn = lv_obj_get_child(row, col);
+    size_t app_index = (size_t)index * GRID_COLUMNS + col;
+    if (app_index >= user_app_count) {
+      lv_obj_set_user_data(btn, NULL);
+      lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+      continue;
+    }
+
+    const app_descriptor_t *app = user_apps[app_index];
+    lv_obj_t *icon = lv_obj_get_child(btn, 0);
+    lv_obj_t *label = lv_obj_get_child(btn, 1);
+    lv_obj_set_user_data(btn, (void *)app);
+    lv_obj_set_user_data(icon, (void *)app);
+    lv_label_set_text_static(label, app->name);
+
+    // One line under the icon, or centered (and wrapped) without one
+    lv_area_t region;
+    if (asset_pack_get_region(app->icon, ICON_ATLAS, &region) ||
+        asset_pack_has(app->icon)) {
+      const lv_font_t *font = lv_obj_get_style_text_font(label, 0);
+      lv_obj_clear_flag(icon, LV_OBJ_FLAG_HIDDEN);
+      lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+      lv_obj_set_height(label, lv_font_get_line_height(font));
+      lv_obj_align(label, LV_ALIGN_BOTTOM_MID, 0, 0);
+    } else {
+      lv_obj_add_flag(icon, LV_OBJ_FLAG_HIDDEN);
+      lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+      lv_obj_set_height(label, LV_SIZE_CONTENT);
+      lv_obj_center(label);
+    }
+    lv_obj_invalidate(icon);
+    lv_obj_clear_flag(btn, LV_OBJ_FLAG_HIDDEN);
+  }
 }
 
 /**
@@ -23,45 +164,33 @@ static void app_icon_clicked(lv_event_t *e) {
  */
 static lv_obj_t *launcher_app_create(void) {
   lv_obj_t *screen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(screen, lv_color_hex(THEME_COLOR_BG), 0);
+  lv_obj_add_style(screen, &theme_style_screen, 0);
   lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
 
   // Title
   lv_obj_t *title = lv_label_create(screen);
   lv_label_set_text(title, "Apps");
-  lv_obj_set_style_text_font(title, THEME_FONT_MEDIUM, 0);
-  lv_obj_set_style_text_color(title, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(title, &theme_style_title, 0);
   lv_obj_set_pos(title, 20, 20);
 
-  // App grid container
-  lv_obj_t *grid = lv_obj_create(screen);
-  lv_obj_set_size(grid, 220, 180);
-  lv_obj_set_pos(grid, 10, 60);
-  lv_obj_set_style_bg_color(grid, lv_color_hex(THEME_COLOR_BG), 0);
-  lv_obj_set_style_border_width(grid, 0, 0);
-  lv_obj_set_style_pad_all(grid, 10, 0);
-  lv_obj_set_flex_flow(grid, LV_FLEX_FLOW_ROW_WRAP);
-  lv_obj_set_flex_align(grid, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START,
-                        LV_FLEX_ALIGN_START);
-  lv_obj_set_style_pad_row(grid, 15, 0);
-  lv_obj_set_style_pad_column(grid, 15, 0);
-  lv_obj_clear_flag(grid, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Create app icon for System Info
-  lv_obj_t *btn = lv_btn_create(grid);
-  lv_obj_set_size(btn, 80, 80);
-  lv_obj_set_style_bg_color(btn, lv_color_hex(THEME_COLOR_ORANGE), 0);
-  lv_obj_set_style_radius(btn, 10, 0);
-  lv_obj_add_event_cb(btn, app_icon_clicked, LV_EVENT_CLICKED,
-                      (void *)(intptr_t)APP_USER_SYSTEM_INFO);
-
-  // App label
-  lv_obj_t *label = lv_label_create(btn);
-  lv_label_set_text(label, "System\nInfo");
-  lv_obj_set_style_text_font(label, THEME_FONT_SMALL, 0);
-  lv_obj_set_style_text_color(label, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-  lv_obj_center(label);
+  // App grid: recycled rows, so its cost doesn't grow with the app count
+  app_grid = virtual_list_create(screen, CELL_SIZE, CELL_GAP, create_app_row,
+                                 bind_app_row, NULL);
+  if (app_grid == NULL) {
+    ESP_LOGE(TAG, "Failed to create app grid");
+    lv_obj_delete(screen);
+    return NULL;
+  }
+  lv_obj_set_size(app_grid, 220, 180);
+  lv_obj_set_pos(app_grid, 10, 60);
+  lv_obj_add_style(app_grid, &theme_style_container, 0);
+  lv_obj_set_style_pad_all(app_grid, 10, 0);
+
+  // Allow gestures to propagate when at scroll boundaries
+  lv_obj_add_flag(app_grid, LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+  // Side margins are plain background, so the panel can scroll the rows
+  display_manager_attach_hw_scroll(app_grid);
 
   ESP_LOGI(TAG, "App launcher screen created");
   return screen;
@@ -70,6 +199,18 @@ static lv_obj_t *launcher_app_create(void) {
 static void launcher_app_on_show(void) {
   ESP_LOGI(TAG, "App launcher screen shown");
   navigation_manager_set_context(NAV_CONTEXT_SYSTEM_SCREEN);
+
+  // Registration only happens at boot, so the grid is rebound only if the
+  // registry grew since the last time
+  size_t count;
+  const app_descriptor_t **apps = app_manager_get_user_apps(&count);
+  if (count != user_app_count) {
+    user_apps = apps;
+    user_app_count = count;
+    virtual_list_set_count(app_grid,
+                           (count + GRID_COLUMNS - 1) / GRID_COLUMNS);
+    ESP_LOGI(TAG, "Launcher shows %u apps", (unsigned)count);
+  }
 }
 
 static void launcher_app_on_hide(void) {
@@ -1,56 +1,120 @@
 #include "ui/apps/notifications_app.h"
+#include "core/display_manager.h"
+#include "core/event_manager.h"
 #include "core/navigation_manager.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
 #include "lvgl.h"
 #include "services/notification_service.h"
+#include "services/storage_service.h"
+#include "ui/font_store.h"
 #include "ui/theme.h"
+#include "ui/widgets/virtual_list.h"
 
 static const char *TAG = "notifications_app";
 
+// Notification cards
+#define ROW_WIDTH 200
+#define ROW_HEIGHT 96
+#define ROW_GAP 10
+
 static lv_obj_t *notification_list = NULL;
+static lv_obj_t *empty_label = NULL;
+static uint32_t shown_generation = UINT32_MAX; // History the list shows
+
+// Store fonts for notification text, which can be in any script. Shared
+// styles, added on top of the theme roles when the font files exist.
+static lv_style_t title_font_style;
+static lv_style_t message_font_style;
+static bool title_font_loaded = false;
+static bool message_font_loaded = false;
 
 /**
- * @brief Create a single notification item widget
+ * @brief Load a store font into a shared style
  */
-static void create_notification_item(lv_obj_t *parent,
-                                     const notification_t *notif) {
+static bool load_font_style(lv_style_t *style, const char *path,
+                            const lv_font_t *fallback) {
+  if (!storage_service_is_mounted()) {
+    return false;
+  }
+
+  const lv_font_t *font = font_store_open(path, fallback);
+  if (font == NULL) {
+    return false;
+  }
+
+  lv_style_init(style);
+  lv_style_set_text_font(style, font);
+  return true;
+}
+
+/**
+ * @brief Create an empty notification card (a virtual list row)
+ */
+static lv_obj_t *create_notification_row(lv_obj_t *list, void *user_data) {
   // Item container
-  lv_obj_t *item = lv_obj_create(parent);
-  lv_obj_set_width(item, 200);
-  lv_obj_set_height(item, LV_SIZE_CONTENT);
-  lv_obj_set_style_bg_color(item, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_style_radius(item, 10, 0);
-  lv_obj_set_style_pad_all(item, 10, 0);
-  lv_obj_set_style_border_width(item, 0, 0);
+  lv_obj_t *item = lv_obj_create(list);
+  lv_obj_set_size(item, ROW_WIDTH, ROW_HEIGHT);
+  lv_obj_set_x(item, (lv_obj_get_content_width(list) - ROW_WIDTH) / 2);
+  lv_obj_add_style(item, &theme_style_card, 0);
   lv_obj_clear_flag(item, LV_OBJ_FLAG_SCROLLABLE);
 
   // Title
   lv_obj_t *title = lv_label_create(item);
-  lv_label_set_text(title, notif->title);
-  lv_obj_set_style_text_font(title, THEME_FONT_NORMAL, 0);
-  lv_obj_set_style_text_color(title, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(title, &theme_style_label, 0);
+  if (title_font_loaded) {
+    lv_obj_add_style(title, &title_font_style, 0);
+  }
+  lv_obj_set_width(title, ROW_WIDTH - 20);
+  lv_label_set_long_mode(title, LV_LABEL_LONG_DOT);
   lv_obj_align(title, LV_ALIGN_TOP_LEFT, 0, 0);
 
-  // Message
+  // Message, cut to two lines so every row has the same height
   lv_obj_t *message = lv_label_create(item);
-  lv_label_set_text(message, notif->message);
-  lv_obj_set_style_text_font(message, THEME_FONT_SMALL, 0);
-  lv_obj_set_style_text_color(message, lv_color_hex(THEME_COLOR_GRAY), 0);
-  lv_obj_set_width(message, 180);
-  lv_label_set_long_mode(message, LV_LABEL_LONG_WRAP);
+  lv_obj_add_style(message, &theme_style_caption, 0);
+  if (message_font_loaded) {
+    lv_obj_add_style(message, &message_font_style, 0);
+  }
+  const lv_font_t *font = lv_obj_get_style_text_font(message, 0);
+  lv_obj_set_size(message, ROW_WIDTH - 20, 2 * lv_font_get_line_height(font));
+  lv_label_set_long_mode(message, LV_LABEL_LONG_DOT);
   lv_obj_align(message, LV_ALIGN_TOP_LEFT, 0, 22);
 
   // App name
   lv_obj_t *app_name = lv_label_create(item);
-  lv_label_set_text(app_name, notif->app_name);
-  lv_obj_set_style_text_font(app_name, THEME_FONT_SMALL, 0);
-  lv_obj_set_style_text_color(app_name, lv_color_hex(THEME_COLOR_ORANGE), 0);
+  lv_obj_add_style(app_name, &theme_style_caption_accent, 0);
   lv_obj_align(app_name, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+  return item;
+}
+
+/**
+ * @brief Show notification index (0 = newest) in a card
+ */
+static void bind_notification_row(lv_obj_t *row, uint32_t index,
+                                  void *user_data) {
+  uint32_t count;
+  const notification_t *notifications = notification_service_get_all(&count);
+  if (index >= count) {
+    return;
+  }
+
+  const notification_t *notif = &notifications[index];
+  lv_label_set_text(lv_obj_get_child(row, 0), notif->title);
+  lv_label_set_text(lv_obj_get_child(row, 1), notif->message);
+  lv_label_set_text(lv_obj_get_child(row, 2), notif->app_name);
+}
+
+static void update_empty_state(uint32_t count) {
+  if (count == 0) {
+    lv_obj_clear_flag(empty_label, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_add_flag(empty_label, LV_OBJ_FLAG_HIDDEN);
+  }
 }
 
 /**
- * @brief Refresh notification list
+ * @brief Refresh notification list (skipped when already up to date)
  */
 static void refresh_notification_list(void) {
   if (notification_list == NULL) {
@@ -60,28 +124,51 @@ static void refresh_notification_list(void) {
 
   // NOTE: No lvgl_port_lock needed - called from on_show which is already in LVGL context
 
-  // Clear existing list
-  lv_obj_clean(notification_list);
+  uint32_t generation = notification_service_get_generation();
+  if (generation == shown_generation) {
+    return;
+  }
 
-  // Get all notifications
-  uint32_t count;
-  const notification_t *notifications = notification_service_get_all(&count);
+  uint32_t count = notification_service_get_count();
+  virtual_list_set_count(notification_list, count);
+  update_empty_state(count);
+  shown_generation = generation;
 
-  if (count == 0) {
-    // Show "No notifications" message
-    lv_obj_t *label = lv_label_create(notification_list);
-    lv_label_set_text(label, "No notifications");
-    lv_obj_set_style_text_font(label, THEME_FONT_NORMAL, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(THEME_COLOR_GRAY), 0);
-    lv_obj_center(label);
-  } else {
-    // Render notifications (index 0 = newest)
-    for (uint32_t i = 0; i < count && i < 10; i++) {
-      create_notification_item(notification_list, &notifications[i]);
+  ESP_LOGI(TAG, "Notification list refreshed: %lu items",
+           (unsigned long)count);
+}
+
+/**
+ * @brief Apply history changes to the list as they happen
+ *
+ * The service has already updated the history (it subscribed first).
+ */
+static void notification_event_cb(const event_t *event, void *user_data) {
+  lvgl_port_lock(-1);
+
+  uint32_t count = notification_service_get_count();
+  uint32_t listed = virtual_list_get_count(notification_list);
+
+  if (event->type == EVENT_NOTIFICATION_NEW) {
+    if (listed == count) {
+      virtual_list_remove(notification_list, listed - 1); // Oldest dropped
     }
+    virtual_list_insert(notification_list, 0);
+  } else if (event->data != NULL) {
+    const notification_clear_t *clear = event->data;
+    virtual_list_remove(notification_list, clear->index);
+  } else {
+    virtual_list_set_count(notification_list, 0);
+  }
+
+  // Missed a change: fall back to a full refresh
+  if (virtual_list_get_count(notification_list) != count) {
+    virtual_list_set_count(notification_list, count);
   }
+  update_empty_state(count);
+  shown_generation = notification_service_get_generation();
 
-  ESP_LOGI(TAG, "Notification list refreshed: %d items", count);
+  lvgl_port_unlock();
 }
 
 /**
@@ -89,32 +176,56 @@ static void refresh_notification_list(void) {
  */
 static lv_obj_t *notifications_app_create(void) {
   lv_obj_t *screen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(screen, lv_color_hex(THEME_COLOR_BG), 0);
+  lv_obj_add_style(screen, &theme_style_screen, 0);
+
+  if (!title_font_loaded) {
+    title_font_loaded = load_font_style(
+        &title_font_style, STORAGE_BASE_PATH "/fonts/text16.fnt",
+        THEME_FONT_NORMAL);
+  }
+  if (!message_font_loaded) {
+    message_font_loaded = load_font_style(
+        &message_font_style, STORAGE_BASE_PATH "/fonts/text14.fnt",
+        THEME_FONT_SMALL);
+  }
   lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
 
   // Title
   lv_obj_t *title = lv_label_create(screen);
   lv_label_set_text(title, "Notifications");
-  lv_obj_set_style_text_font(title, THEME_FONT_MEDIUM, 0);
-  lv_obj_set_style_text_color(title, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(title, &theme_style_title, 0);
   lv_obj_set_pos(title, 20, 20);
 
-  // Notification list container (scrollable)
-  notification_list = lv_obj_create(screen);
+  // Notification list: recycles a few cards over the whole history
+  notification_list =
+      virtual_list_create(screen, ROW_HEIGHT, ROW_GAP, create_notification_row,
+                          bind_notification_row, NULL);
   lv_obj_set_size(notification_list, 220, 190);
   lv_obj_set_pos(notification_list, 10, 50);
-  lv_obj_set_style_bg_color(notification_list, lv_color_hex(THEME_COLOR_BG), 0);
-  lv_obj_set_style_border_width(notification_list, 0, 0);
-  lv_obj_set_style_pad_all(notification_list, 0, 0);
-  lv_obj_set_flex_flow(notification_list, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_flex_align(notification_list, LV_FLEX_ALIGN_START,
-                        LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  lv_obj_set_style_pad_row(notification_list, 10, 0);
-  lv_obj_set_scroll_dir(notification_list, LV_DIR_VER);
-  
+  lv_obj_add_style(notification_list, &theme_style_container, 0);
+
   // Allow gestures to propagate when at scroll boundaries
   lv_obj_add_flag(notification_list, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
+  // Side margins are plain background, so the panel can scroll the rows
+  display_manager_attach_hw_scroll(notification_list);
+
+  // Empty state
+  empty_label = lv_label_create(screen);
+  lv_label_set_text(empty_label, "No notifications");
+  lv_obj_add_style(empty_label, &theme_style_label_muted, 0);
+  lv_obj_align(empty_label, LV_ALIGN_CENTER, 0, 25);
+  lv_obj_add_flag(empty_label, LV_OBJ_FLAG_HIDDEN);
+
+  // Live updates; the screen is persistent so these stay subscribed. If
+  // they fail, the list still catches up when shown
+  if (event_manager_subscribe(EVENT_NOTIFICATION_NEW, notification_event_cb,
+                              NULL) != ESP_OK ||
+      event_manager_subscribe(EVENT_NOTIFICATION_CLEAR, notification_event_cb,
+                              NULL) != ESP_OK) {
+    ESP_LOGW(TAG, "No live notification updates");
+  }
+
   ESP_LOGI(TAG, "Notifications screen created");
   return screen;
 }
@@ -4,6 +4,7 @@
 #include "esp_lvgl_port.h"
 #include "esp_system.h"
 #include "lvgl.h"
+#include "ui/asset_pack.h"
 #include "ui/theme.h"
 #include <stdio.h>
 
@@ -30,23 +31,20 @@ static void system_info_on_gesture(lv_dir_t direction) {
 
 static lv_obj_t *system_info_create_ui(void) {
   app_screen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(app_screen, lv_color_hex(THEME_COLOR_BG), 0);
+  lv_obj_add_style(app_screen, &theme_style_screen, 0);
   lv_obj_clear_flag(app_screen, LV_OBJ_FLAG_SCROLLABLE);
 
   // Title
   lv_obj_t *title = lv_label_create(app_screen);
   lv_label_set_text(title, "System Info");
-  lv_obj_set_style_text_font(title, THEME_FONT_MEDIUM, 0);
-  lv_obj_set_style_text_color(title, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(title, &theme_style_title, 0);
   lv_obj_set_pos(title, 20, 10);
 
   // Info container
   lv_obj_t *info_container = lv_obj_create(app_screen);
   lv_obj_set_size(info_container, 220, 230);
   lv_obj_set_pos(info_container, 10, 50);
-  lv_obj_set_style_bg_color(info_container, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_style_border_width(info_container, 0, 0);
-  lv_obj_set_style_radius(info_container, 10, 0);
+  lv_obj_add_style(info_container, &theme_style_card, 0);
   lv_obj_set_style_pad_all(info_container, 15, 0);
   lv_obj_set_scroll_dir(info_container, LV_DIR_VER);
 
@@ -54,8 +52,7 @@ static lv_obj_t *system_info_create_ui(void) {
   lv_obj_t *info_label = lv_label_create(info_container);
   lv_obj_set_width(info_label, 190);
   lv_label_set_long_mode(info_label, LV_LABEL_LONG_WRAP);
-  lv_obj_set_style_text_font(info_label, &lv_font_montserrat_12, 0);
-  lv_obj_set_style_text_color(info_label, lv_color_hex(THEME_COLOR_BLACK), 0);
+  lv_obj_add_style(info_label, &theme_style_detail, 0);
 
   // Build system info string
   char info_buf[512];
@@ -98,7 +95,7 @@ static const app_descriptor_t system_info_descriptor = {
     .id = APP_USER_SYSTEM_INFO,
     .type = APP_TYPE_USER,
     .name = "System Info",
-    .icon = NULL,
+    .icon = ASSET_SRC("app_sysinfo"),
     .create = system_info_create_ui,
     .destroy = system_info_destroy_ui,
     .on_show = system_info_on_launch,
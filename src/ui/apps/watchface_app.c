@@ -1,90 +1,428 @@
 #include "ui/apps/watchface_app.h"
+#include "aa_mask.h"
+#include "core/display_manager.h"
 #include "core/event_manager.h"
 #include "core/navigation_manager.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
 #include "lvgl.h"
 #include "services/battery_service.h"
+#include "services/notification_service.h"
 #include "services/steps_service.h"
+#include "services/storage_service.h"
 #include "services/time_service.h"
+#include "ui/asset_pack.h"
+#include "ui/binding.h"
 #include "ui/theme.h"
+#include "ui/watchface_file.h"
+#include "ui/widgets/analog_face.h"
+#include "ui/widgets/sprite_blit.h"
+#include "ui/widgets/watchface_engine.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
 #include <time.h>
 
 static const char *TAG = "watchface_app";
 
+// Rows kept lit in ambient mode (time + date)
+#define AMBIENT_Y_START 60
+#define AMBIENT_Y_END 145
+
+// Faces compiled with tools/wfc.py (8.3 names)
+#define FACES_DIR STORAGE_BASE_PATH "/faces"
+#define FACE_FILES_MAX 8
+#define FACE_NAME_MAX 13
+
+// Layout
+#define MORSE_X 20
+#define MORSE_Y 155
+#define BATTERY_X 218
+#define BATTERY_DOTS 5
+#define BATTERY_SPACING 14
+#define BATTERY_Y (MORSE_Y + 16 - (BATTERY_DOTS - 1) * BATTERY_SPACING)
+#define PROGRESS_Y 220
+#define PROGRESS_DOTS 15
+#define PROGRESS_SPACING ((BATTERY_X - MORSE_X) / (PROGRESS_DOTS - 1))
+#define NOTIFY_DOT_X 23
+#define NOTIFY_DOT_Y 12
+#define NOTIFY_DOT_SIZE 4
+
+// Palette indices
+enum { PAL_WHITE, PAL_BLACK, PAL_ORANGE };
+
+// Engine slots
+enum { SLOT_BATTERY, SLOT_PROGRESS };
+enum { TEXT_TIME, TEXT_DATE };
+
+#define RECT(px, py, pw, ph, r, c)                                             \
+  {.type = WATCHFACE_PRIM_RECT, .radius = (r), .color = (c), .x = (px),        \
+   .y = (py), .w = (pw), .h = (ph)}
+#define DOT(px, py, size, c) RECT(px, py, size, size, WATCHFACE_RADIUS_CIRCLE, c)
+#define BAR(px, py) RECT(px, py, 25, 10, 5, PAL_BLACK)
+#define MORSE_DOT(px, py) DOT(px, py, 8, PAL_ORANGE)
+
+// Battery dots light up from the bottom: dot i is lit when filled > 4 - i
+#define BATTERY_DOT(i)                                                         \
+  {.type = WATCHFACE_PRIM_RECT, .bind = WATCHFACE_BIND_LEVEL,                  \
+   .slot = SLOT_BATTERY, .index = BATTERY_DOTS - 1 - (i),                      \
+   .radius = WATCHFACE_RADIUS_CIRCLE, .color = PAL_WHITE,                      \
+   .color_on = PAL_ORANGE, .x = BATTERY_X,                                     \
+   .y = BATTERY_Y + (i) * BATTERY_SPACING, .w = 8, .h = 8}
+
+#define PROGRESS_DOT(i)                                                        \
+  {.type = WATCHFACE_PRIM_RECT, .bind = WATCHFACE_BIND_LEVEL,                  \
+   .slot = SLOT_PROGRESS, .index = (i), .radius = WATCHFACE_RADIUS_CIRCLE,     \
+   .color = PAL_WHITE, .color_on = PAL_ORANGE,                                 \
+   .x = MORSE_X + (i) * PROGRESS_SPACING, .y = PROGRESS_Y, .w = 6, .h = 6}
+
+static const watchface_prim_t watchface_prims[] = {
+    // Top icon (artwork from the asset pack over a plain fallback); the
+    // notification dot next to it is a sprite
+    RECT(12, 12, 8, 8, 2, PAL_WHITE),
+    {.type = WATCHFACE_PRIM_IMAGE, .x = 12, .y = 12, .w = 8, .h = 8,
+     .text = ASSET_SRC("wf_icon")},
+
+    // Time and date (the only primitives lit in ambient mode)
+    {.type = WATCHFACE_PRIM_DIGITS, .bind = WATCHFACE_BIND_TEXT,
+     .slot = TEXT_TIME, .color = PAL_BLACK, .flags = WATCHFACE_FLAG_AMBIENT,
+     .x = 20, .y = 70, .w = 180, .h = 48, .font = THEME_FONT_LARGE},
+    {.type = WATCHFACE_PRIM_TEXT, .bind = WATCHFACE_BIND_TEXT,
+     .slot = TEXT_DATE, .color = PAL_BLACK, .flags = WATCHFACE_FLAG_AMBIENT,
+     .x = 20, .y = 118, .w = 160, .h = 20, .font = THEME_FONT_NORMAL},
+
+    // Charge icon and battery dots
+    {.type = WATCHFACE_PRIM_TEXT, .color = PAL_WHITE, .x = BATTERY_X,
+     .y = BATTERY_Y - 20, .w = 16, .h = 16, .font = THEME_FONT_SMALL,
+     .text = LV_SYMBOL_CHARGE},
+    BATTERY_DOT(0), BATTERY_DOT(1), BATTERY_DOT(2), BATTERY_DOT(3),
+    BATTERY_DOT(4),
+
+    // Morse line 1: - . . . .
+    BAR(MORSE_X, MORSE_Y),
+    MORSE_DOT(MORSE_X + 33, MORSE_Y), MORSE_DOT(MORSE_X + 48, MORSE_Y),
+    MORSE_DOT(MORSE_X + 63, MORSE_Y), MORSE_DOT(MORSE_X + 78, MORSE_Y),
+
+    // Morse line 2: . . . - -
+    MORSE_DOT(MORSE_X, MORSE_Y + 16), MORSE_DOT(MORSE_X + 15, MORSE_Y + 16),
+    MORSE_DOT(MORSE_X + 30, MORSE_Y + 16),
+    BAR(MORSE_X + 45, MORSE_Y + 15), BAR(MORSE_X + 78, MORSE_Y + 15),
+
+    // Morse line 3: - - - - -
+    BAR(MORSE_X, MORSE_Y + 32), BAR(MORSE_X + 33, MORSE_Y + 32),
+    BAR(MORSE_X + 66, MORSE_Y + 32), BAR(MORSE_X + 99, MORSE_Y + 32),
+    BAR(MORSE_X + 132, MORSE_Y + 32),
+
+    // Progress dots (steps / goal)
+    PROGRESS_DOT(0), PROGRESS_DOT(1), PROGRESS_DOT(2), PROGRESS_DOT(3),
+    PROGRESS_DOT(4), PROGRESS_DOT(5), PROGRESS_DOT(6), PROGRESS_DOT(7),
+    PROGRESS_DOT(8), PROGRESS_DOT(9), PROGRESS_DOT(10), PROGRESS_DOT(11),
+    PROGRESS_DOT(12), PROGRESS_DOT(13), PROGRESS_DOT(14),
+
+    // Runner (moves along the progress dots)
+    {.type = WATCHFACE_PRIM_RECT, .bind = WATCHFACE_BIND_TRACK,
+     .slot = SLOT_PROGRESS, .radius = 2, .color = PAL_BLACK,
+     .x = MORSE_X - 2, .y = PROGRESS_Y - 2, .w = 10, .h = 10,
+     .step = PROGRESS_SPACING},
+};
+
+// Static decoration rendered once into retained images
+static const lv_area_t watchface_static_layers[] = {
+    {12, 12, 19, 19}, // Top icon
+    {BATTERY_X, BATTERY_Y - 20, BATTERY_X + 15, BATTERY_Y - 5}, // Charge
+    {MORSE_X, MORSE_Y, MORSE_X + 156, MORSE_Y + 41}, // Morse pattern
+};
+
+static const watchface_face_t watchface_face = {
+    .prims = watchface_prims,
+    .prim_count = sizeof(watchface_prims) / sizeof(watchface_prims[0]),
+    .static_layers = watchface_static_layers,
+    .static_layer_count =
+        sizeof(watchface_static_layers) / sizeof(watchface_static_layers[0]),
+    .palette = {THEME_COLOR_WHITE, THEME_COLOR_BLACK, THEME_COLOR_ORANGE},
+    .ambient_palette = {THEME_AMBIENT_COLOR_FG, THEME_AMBIENT_COLOR_FG,
+                        THEME_AMBIENT_COLOR_ACCENT},
+};
+
 // UI elements
-static lv_obj_t *lbl_time = NULL;
-static lv_obj_t *lbl_date = NULL;
-static lv_obj_t *battery_dots[5];
-static lv_obj_t *progress_dots[15];
-static lv_obj_t *runner_icon = NULL;
+static lv_obj_t *screen_obj = NULL;
+static lv_obj_t *face_obj = NULL;
+static lv_obj_t *analog_obj = NULL;
+static lv_obj_t *file_obj = NULL;
+
+// Notification dot: blitted straight to the panel when it changes
+enum { DOT_FRAME_OFF, DOT_FRAME_ON, DOT_FRAME_AMBIENT, DOT_FRAME_COUNT };
+static uint16_t dot_frames[DOT_FRAME_COUNT][NOTIFY_DOT_SIZE * NOTIFY_DOT_SIZE];
+static lv_obj_t *dot_obj = NULL;
+
+// Long press cycles digital -> face files -> analog
+typedef enum { FACE_DIGITAL, FACE_FILE, FACE_ANALOG } face_kind_t;
+static face_kind_t face_kind = FACE_DIGITAL;
+static bool shown = false;
+
+// Face files found in FACES_DIR; only the selected one is loaded
+static char face_files[FACE_FILES_MAX][FACE_NAME_MAX];
+static uint8_t face_file_count = 0;
+static uint8_t face_file_index = 0;
+static watchface_file_t *face_file = NULL;
+static watchface_model_t face_model;
 
 // Current values from services
 static uint8_t current_battery = 0;
 static uint32_t current_steps = 0;
 
+// Ambient mode: reduced palette, frozen decorations
+static bool ambient = false;
+
+static int32_t time_key(const void *model) {
+  const struct tm *time = model;
+  return time->tm_hour * 60 + time->tm_min;
+}
+
+static int32_t date_key(const void *model) {
+  const struct tm *time = model;
+  return time->tm_year * 366 + time->tm_yday;
+}
+
+static void format_time(const void *model, char *out, size_t size) {
+  strftime(out, size, "%H:%M", model); // "14:35"
+}
+
+static void format_date(const void *model, char *out, size_t size) {
+  strftime(out, size, "%a %d.%m", model); // "Tue 19.12"
+}
+
+static int32_t battery_filled(const void *model) {
+  return (*(const uint8_t *)model * BATTERY_DOTS) / 100;
+}
+
+static int32_t steps_progress(const void *model) {
+  // Calculate progress based on steps (0-goal = 0-15 dots)
+  uint32_t goal = steps_service_get_goal();
+  int32_t progress = (*(const uint32_t *)model * PROGRESS_DOTS) / goal;
+  return progress > PROGRESS_DOTS ? PROGRESS_DOTS : progress;
+}
+
+static void apply_face_text(const binding_t *binding, int32_t value,
+                            const char *text) {
+  watchface_engine_set_text(binding->target, binding->slot, text);
+}
+
+static void apply_face_value(const binding_t *binding, int32_t value,
+                             const char *text) {
+  watchface_engine_set_value(binding->target, binding->slot, value);
+}
+
+static binding_t time_binding = {
+    .name = "time",
+    .map = time_key,
+    .format = format_time,
+    .apply = apply_face_text,
+    .slot = TEXT_TIME,
+};
+static binding_t date_binding = {
+    .name = "date",
+    .map = date_key,
+    .format = format_date,
+    .apply = apply_face_text,
+    .slot = TEXT_DATE,
+};
+static binding_t battery_binding = {
+    .name = "battery",
+    .map = battery_filled,
+    .apply = apply_face_value,
+    .slot = SLOT_BATTERY,
+};
+static binding_t progress_binding = {
+    .name = "steps",
+    .map = steps_progress,
+    .apply = apply_face_value,
+    .slot = SLOT_PROGRESS,
+};
+
+/**
+ * @brief Update time display
+ *
+ * Called every second; the bindings only reach LVGL when the minute or
+ * the day changes.
+ */
+static void update_time_display(const struct tm *time) {
+  face_model.time = *time;
+  if (face_kind == FACE_ANALOG) {
+    analog_face_set_time(analog_obj, time);
+    return;
+  }
+  if (face_kind == FACE_FILE) {
+    watchface_file_update(face_file, file_obj, &face_model);
+    return;
+  }
+  if (face_obj == NULL) {
+    return;
+  }
+
+  binding_update(&time_binding, time);
+  binding_update(&date_binding, time);
+}
+
 /**
- * @brief Create a dot
+ * @brief Sweep the second hand only while the analog face is on screen
  */
-static lv_obj_t *create_dot(lv_obj_t *parent, int x, int y, int size,
-                            lv_color_t color) {
-  lv_obj_t *dot = lv_obj_create(parent);
-  lv_obj_set_size(dot, size, size);
-  lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
-  lv_obj_set_style_bg_color(dot, color, 0);
-  lv_obj_set_style_border_width(dot, 0, 0);
-  lv_obj_set_pos(dot, x, y);
-  lv_obj_clear_flag(dot, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-  return dot;
+static void update_sweep(void) {
+  analog_face_set_sweep(analog_obj, face_kind == FACE_ANALOG && shown &&
+                                        !ambient);
 }
 
 /**
- * @brief Create a bar (rectangle)
+ * @brief Find the face files installed on the ffat partition
  */
-static lv_obj_t *create_bar(lv_obj_t *parent, int x, int y, int w, int h,
-                            lv_color_t color) {
-  lv_obj_t *bar = lv_obj_create(parent);
-  lv_obj_set_size(bar, w, h);
-  lv_obj_set_style_radius(bar, 5, 0);
-  lv_obj_set_style_bg_color(bar, color, 0);
-  lv_obj_set_style_border_width(bar, 0, 0);
-  lv_obj_set_pos(bar, x, y);
-  lv_obj_clear_flag(bar, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-  return bar;
+static void scan_face_files(void) {
+  DIR *dir = opendir(FACES_DIR);
+  if (dir == NULL) {
+    return; // No faces installed
+  }
+
+  struct dirent *entry;
+  while (face_file_count < FACE_FILES_MAX && (entry = readdir(dir)) != NULL) {
+    const char *ext = strrchr(entry->d_name, '.');
+    if (ext == NULL || strcasecmp(ext, ".wfc") != 0 ||
+        strlen(entry->d_name) >= FACE_NAME_MAX) {
+      continue;
+    }
+    strcpy(face_files[face_file_count++], entry->d_name);
+  }
+  closedir(dir);
+  ESP_LOGI(TAG, "Found %u face files in %s", face_file_count, FACES_DIR);
+}
+
+static void unload_face_file(void) {
+  // The engine object draws from the file's tables, so it goes first
+  if (file_obj != NULL) {
+    lv_obj_delete(file_obj);
+    file_obj = NULL;
+  }
+  if (face_file != NULL) {
+    watchface_file_free(face_file);
+    face_file = NULL;
+  }
+}
+
+static bool load_face_file(uint8_t index) {
+  char path[sizeof(FACES_DIR) + FACE_NAME_MAX + 1];
+  snprintf(path, sizeof(path), FACES_DIR "/%s", face_files[index]);
+  if (watchface_file_load(path, &face_file) != ESP_OK) {
+    return false;
+  }
+
+  file_obj = watchface_engine_create(screen_obj,
+                                     watchface_file_get_face(face_file));
+  if (file_obj == NULL) {
+    ESP_LOGE(TAG, "Failed to create face from %s", path);
+    unload_face_file();
+    return false;
+  }
+  watchface_engine_set_ambient(file_obj, ambient);
+  return true;
 }
 
 /**
- * @brief Update time display
+ * @brief Move to the next face; files that fail to load are skipped
  */
-static void update_time_display(const struct tm *time) {
-  if (lbl_time == NULL || lbl_date == NULL) {
-    return;
+static void select_next_face(void) {
+  uint8_t next_file = (face_kind == FACE_FILE) ? face_file_index + 1 : 0;
+  unload_face_file();
+
+  if (face_kind != FACE_ANALOG) {
+    for (; next_file < face_file_count; next_file++) {
+      if (load_face_file(next_file)) {
+        face_kind = FACE_FILE;
+        face_file_index = next_file;
+        return;
+      }
+    }
+    if (analog_obj != NULL) {
+      face_kind = FACE_ANALOG;
+      return;
+    }
+  }
+  face_kind = FACE_DIGITAL;
+}
+
+/**
+ * @brief Render the dot sprite's frames over the screen background
+ */
+static void render_dot_frames(void) {
+  uint8_t mask[AA_MASK_SIZE(NOTIFY_DOT_SIZE, NOTIFY_DOT_SIZE)];
+  aa_mask_round_rect(mask, NOTIFY_DOT_SIZE, NOTIFY_DOT_SIZE,
+                     NOTIFY_DOT_SIZE / 2);
+
+  lv_color_t bg = lv_color_hex(THEME_COLOR_BG);
+  lv_color_t dot = lv_color_hex(THEME_COLOR_ORANGE);
+  uint16_t ambient_bg = lv_color_to_u16(lv_color_hex(THEME_AMBIENT_COLOR_BG));
+  for (size_t i = 0; i < sizeof(mask); i++) {
+    dot_frames[DOT_FRAME_OFF][i] = lv_color_to_u16(bg);
+    dot_frames[DOT_FRAME_ON][i] =
+        lv_color_to_u16(lv_color_mix(dot, bg, mask[i]));
+    dot_frames[DOT_FRAME_AMBIENT][i] = ambient_bg; // Row is dark in ambient
   }
+}
 
-  char time_str[16];
-  char date_str[32];
+/**
+ * @brief Show the dot while there are unread notifications
+ */
+static void update_notification_dot(void) {
+  if (dot_obj == NULL) {
+    return;
+  }
+  if (face_kind != FACE_DIGITAL) {
+    lv_obj_add_flag(dot_obj, LV_OBJ_FLAG_HIDDEN);
+    return;
+  }
 
-  // Format time: "14:35"
-  strftime(time_str, sizeof(time_str), "%H:%M", time);
-  lv_label_set_text(lbl_time, time_str);
+  lv_obj_clear_flag(dot_obj, LV_OBJ_FLAG_HIDDEN);
+  sprite_blit_set_frame(dot_obj, ambient ? DOT_FRAME_AMBIENT
+                                 : notification_service_get_count() > 0
+                                     ? DOT_FRAME_ON
+                                     : DOT_FRAME_OFF);
+}
 
-  // Format date: "Tue 19.12"
-  strftime(date_str, sizeof(date_str), "%a %d.%m", time);
-  lv_label_set_text(lbl_date, date_str);
+/**
+ * @brief Show the selected face
+ */
+static void apply_face(void) {
+  if (face_kind == FACE_DIGITAL) {
+    lv_obj_clear_flag(face_obj, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_add_flag(face_obj, LV_OBJ_FLAG_HIDDEN);
+  }
+  if (analog_obj != NULL && face_kind != FACE_ANALOG) {
+    lv_obj_add_flag(analog_obj, LV_OBJ_FLAG_HIDDEN);
+  } else if (analog_obj != NULL) {
+    lv_obj_clear_flag(analog_obj, LV_OBJ_FLAG_HIDDEN);
+  }
+  update_notification_dot();
+
+  uint16_t y_start, y_end;
+  if (face_kind == FACE_DIGITAL) {
+    // Ambient mode keeps only the time and date rows lit
+    display_manager_set_ambient_area(true, AMBIENT_Y_START, AMBIENT_Y_END);
+  } else if (face_kind == FACE_FILE &&
+             watchface_file_get_ambient_rows(face_file, &y_start, &y_end)) {
+    display_manager_set_ambient_area(true, y_start, y_end);
+  } else {
+    // The hands (or an unrestricted face) cover the whole panel
+    display_manager_set_ambient_area(false, 0, 0);
+  }
 }
 
 /**
  * @brief Update battery display (simulated for now)
  */
 static void update_battery_display(void) {
-  int filled = (current_battery * 5) / 100;
-
-  for (int i = 0; i < 5; i++) {
-    lv_obj_set_style_bg_color(battery_dots[i],
-                              (i >= 5 - filled)
-                                  ? lv_color_hex(THEME_COLOR_ORANGE)
-                                  : lv_color_hex(THEME_COLOR_WHITE),
-                              0);
+  binding_update(&battery_binding, &current_battery);
+  face_model.battery = current_battery;
+  if (face_kind == FACE_FILE) {
+    watchface_file_update(face_file, file_obj, &face_model);
   }
 }
 
@@ -92,32 +430,66 @@ static void update_battery_display(void) {
  * @brief Update progress display (simulated steps for now)
  */
 static void update_progress_display(void) {
-  int morse_x_start = 20;
-  int battery_x = 218;
-  int dot_start_x = morse_x_start;
-  int dot_end_x = battery_x;
-  int num_dots = 15;
-  int total_width = dot_end_x - dot_start_x;
-  int dot_spacing = total_width / (num_dots - 1);
+  binding_update(&progress_binding, &current_steps);
+  face_model.steps = current_steps;
+  face_model.steps_goal = steps_service_get_goal();
+  if (face_kind == FACE_FILE) {
+    watchface_file_update(face_file, file_obj, &face_model);
+  }
+}
 
-  // Calculate progress based on steps (0-goal = 0-15 dots)
-  uint32_t goal = steps_service_get_goal();
-  int progress = (current_steps * num_dots) / goal;
-  if (progress > num_dots)
-    progress = num_dots;
-
-  for (int i = 0; i < num_dots; i++) {
-    if (i < progress) {
-      lv_obj_set_style_bg_color(progress_dots[i],
-                                lv_color_hex(THEME_COLOR_ORANGE), 0);
-    } else {
-      lv_obj_set_style_bg_color(progress_dots[i],
-                                lv_color_hex(THEME_COLOR_WHITE), 0);
-    }
+/**
+ * @brief Switch between the normal and the 8-colour ambient palette
+ */
+static void apply_palette(void) {
+  lv_obj_remove_style(screen_obj, &theme_style_screen, 0);
+  lv_obj_remove_style(screen_obj, &theme_style_screen_ambient, 0);
+  lv_obj_add_style(screen_obj,
+                   ambient ? &theme_style_screen_ambient : &theme_style_screen,
+                   0);
+  watchface_engine_set_ambient(face_obj, ambient);
+  watchface_engine_set_ambient(file_obj, ambient);
+  analog_face_set_ambient(analog_obj, ambient);
+  update_notification_dot();
+}
+
+/**
+ * @brief Event callback for ambient mode changes
+ *
+ * Subscribed for the lifetime of the screen, so the palette is right even
+ * if ambient mode is entered while another app is shown.
+ */
+static void ambient_event_callback(const event_t *event, void *user_data) {
+  ambient = (event->type == EVENT_SYSTEM_AMBIENT_ENTER);
+
+  struct tm time;
+  time_service_get_time(&time);
+
+  lvgl_port_lock(-1);
+  apply_palette();
+  update_sweep();
+  update_time_display(&time);
+  if (!ambient) {
+    // Decorations were frozen while hidden
+    current_battery = battery_service_get_level();
+    current_steps = steps_service_get_count();
+    update_battery_display();
+    update_progress_display();
   }
+  lvgl_port_unlock();
+}
 
-  int runner_x = dot_start_x + progress * dot_spacing - 2;
-  lv_obj_set_pos(runner_icon, runner_x, 218);
+/**
+ * @brief Event callback for notifications arriving or being cleared
+ *
+ * Subscribed for the lifetime of the screen; the service has already
+ * updated its count (it subscribed first).
+ */
+static void notification_event_callback(const event_t *event,
+                                        void *user_data) {
+  lvgl_port_lock(-1);
+  update_notification_dot();
+  lvgl_port_unlock();
 }
 
 /**
@@ -136,6 +508,9 @@ static void time_event_callback(const event_t *event, void *user_data) {
 static void battery_event_callback(const event_t *event, void *user_data) {
   if (event->type == EVENT_BATTERY_UPDATED && event->data != NULL) {
     current_battery = *(uint8_t *)event->data;
+    if (ambient) {
+      return;
+    }
 
     lvgl_port_lock(-1);
     update_battery_display();
@@ -146,6 +521,9 @@ static void battery_event_callback(const event_t *event, void *user_data) {
 static void steps_event_callback(const event_t *event, void *user_data) {
   if (event->type == EVENT_STEPS_UPDATED && event->data != NULL) {
     current_steps = *(uint32_t *)event->data;
+    if (ambient) {
+      return;
+    }
 
     lvgl_port_lock(-1);
     update_progress_display();
@@ -153,135 +531,81 @@ static void steps_event_callback(const event_t *event, void *user_data) {
   }
 }
 
+/**
+ * @brief Long press: switch to the next face
+ */
+static void face_long_pressed_cb(lv_event_t *e) {
+  if (analog_obj == NULL && face_file_count == 0) {
+    return;
+  }
+
+  select_next_face();
+  apply_face();
+
+  struct tm time;
+  time_service_get_time(&time);
+  if (face_kind == FACE_DIGITAL) {
+    // The digital bindings skip values they think are shown
+    binding_reset(&time_binding);
+    binding_reset(&date_binding);
+  }
+  update_time_display(&time);
+  update_sweep();
+  ESP_LOGI(TAG, "Switched to the %s face",
+           face_kind == FACE_FILE    ? face_files[face_file_index]
+           : face_kind == FACE_ANALOG ? "analog"
+                                      : "digital");
+}
+
 /**
  * @brief Create watchface screen
  */
 static lv_obj_t *watchface_app_create(void) {
   lv_obj_t *screen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(screen, lv_color_hex(THEME_COLOR_BG), 0);
+  lv_obj_add_style(screen, &theme_style_screen, 0);
   lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+  screen_obj = screen;
 
-  // Top icon (top-left corner)
-  lv_obj_t *top_icon = lv_obj_create(screen);
-  lv_obj_set_size(top_icon, 8, 8);
-  lv_obj_set_pos(top_icon, 12, 12);
-  lv_obj_set_style_bg_color(top_icon, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_style_border_width(top_icon, 0, 0);
-  lv_obj_set_style_radius(top_icon, 2, 0);
-  lv_obj_clear_flag(top_icon, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-
-  // Notification dot (orange, next to top icon)
-  lv_obj_t *notif_dot = lv_obj_create(screen);
-  lv_obj_set_size(notif_dot, 4, 4);
-  lv_obj_set_pos(notif_dot, 23, 12);
-  lv_obj_set_style_bg_color(notif_dot, lv_color_hex(THEME_COLOR_ORANGE), 0);
-  lv_obj_set_style_border_width(notif_dot, 0, 0);
-  lv_obj_set_style_radius(notif_dot, LV_RADIUS_CIRCLE, 0);
-  lv_obj_clear_flag(notif_dot, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-
-  // Time label (large, centered-ish)
-  lbl_time = lv_label_create(screen);
-  lv_label_set_text(lbl_time, "12:00");
-  lv_obj_set_style_text_font(lbl_time, &lv_font_montserrat_42, 0);
-  lv_obj_set_style_text_color(lbl_time, lv_color_hex(THEME_COLOR_BLACK), 0);
-  lv_obj_set_pos(lbl_time, 20, 70);
-
-  // Date label (below time)
-  lbl_date = lv_label_create(screen);
-  lv_label_set_text(lbl_date, "Tue 19.12");
-  lv_obj_set_style_text_font(lbl_date, &lv_font_montserrat_16, 0);
-  lv_obj_set_style_text_color(lbl_date, lv_color_hex(THEME_COLOR_BLACK), 0);
-  lv_obj_set_pos(lbl_date, 20, 118);
-
-  // Battery display (vertical dots on the right)
-  int battery_x = 218;
-  int morse_line2_y = 155 + 16;
-  int battery_dot_spacing = 14;
-  int battery_y_end = morse_line2_y;
-  int battery_y_start = battery_y_end - 4 * battery_dot_spacing;
-
-  // Charge icon (above battery dots)
-  lv_obj_t *charge_icon = lv_label_create(screen);
-  lv_label_set_text(charge_icon, LV_SYMBOL_CHARGE);
-  lv_obj_set_style_text_font(charge_icon, &lv_font_montserrat_14, 0);
-  lv_obj_set_style_text_color(charge_icon, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_set_pos(charge_icon, battery_x, battery_y_start - 20);
-
-  // Battery dots (5 vertical dots)
-  for (int i = 0; i < 5; i++) {
-    battery_dots[i] =
-        create_dot(screen, battery_x, battery_y_start + i * battery_dot_spacing,
-                   8, lv_color_hex(THEME_COLOR_WHITE));
+  // Every primitive is drawn by one widget from the const table above
+  face_obj = watchface_engine_create(screen, &watchface_face);
+  if (face_obj == NULL) {
+    ESP_LOGE(TAG, "Failed to create watchface");
+    return screen;
+  }
+  binding_t *bindings[] = {&time_binding, &date_binding, &battery_binding,
+                           &progress_binding};
+  for (size_t i = 0; i < sizeof(bindings) / sizeof(bindings[0]); i++) {
+    bindings[i]->target = face_obj;
+    binding_reset(bindings[i]);
   }
 
-  // MORSE code visualization
-  int morse_y = 155;
-  int morse_x_start = 20;
-
-  // Line 1: - · · · ·
-  create_bar(screen, morse_x_start, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_dot(screen, morse_x_start + 33, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_dot(screen, morse_x_start + 48, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_dot(screen, morse_x_start + 63, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_dot(screen, morse_x_start + 78, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-
-  // Line 2: · · · - -
-  morse_y += 16;
-  create_dot(screen, morse_x_start, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_dot(screen, morse_x_start + 15, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_dot(screen, morse_x_start + 30, morse_y, 8,
-             lv_color_hex(THEME_COLOR_ORANGE));
-  create_bar(screen, morse_x_start + 45, morse_y - 1, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_bar(screen, morse_x_start + 78, morse_y - 1, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-
-  // Line 3: - - - - -
-  morse_y += 16;
-  create_bar(screen, morse_x_start, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_bar(screen, morse_x_start + 33, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_bar(screen, morse_x_start + 66, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_bar(screen, morse_x_start + 99, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-  create_bar(screen, morse_x_start + 132, morse_y, 25, 10,
-             lv_color_hex(THEME_COLOR_BLACK));
-
-  // Progress dots (15 dots at the bottom, representing steps/goal)
-  int progress_y = 220;
-  int dot_start_x = morse_x_start;
-  int dot_end_x = battery_x;
-  int total_width = dot_end_x - dot_start_x;
-  int num_dots = 15;
-  int dot_spacing = total_width / (num_dots - 1);
-
-  for (int i = 0; i < num_dots; i++) {
-    progress_dots[i] =
-        create_dot(screen, dot_start_x + i * dot_spacing, progress_y, 6,
-                   lv_color_hex(THEME_COLOR_WHITE));
+  // Later siblings are hidden while the digital face (and the dot) shows
+  render_dot_frames();
+  dot_obj = sprite_blit_create(screen, &dot_frames[0][0], NOTIFY_DOT_SIZE,
+                               NOTIFY_DOT_SIZE, DOT_FRAME_COUNT);
+  if (dot_obj != NULL) {
+    lv_obj_set_pos(dot_obj, NOTIFY_DOT_X, NOTIFY_DOT_Y);
   }
 
-  // Runner icon (moves along the progress dots)
-  runner_icon = lv_obj_create(screen);
-  lv_obj_set_size(runner_icon, 10, 10);
-  lv_obj_set_pos(runner_icon, dot_start_x + 3 * dot_spacing - 2,
-                 progress_y - 2);
-  lv_obj_set_style_bg_color(runner_icon, lv_color_hex(THEME_COLOR_BLACK), 0);
-  lv_obj_set_style_border_width(runner_icon, 0, 0);
-  lv_obj_set_style_radius(runner_icon, 2, 0);
-  lv_obj_clear_flag(runner_icon,
-                    LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
-
-  ESP_LOGI(TAG, "Watchface screen created with full graphics");
+  // Analog option, hidden until selected
+  analog_obj = analog_face_create(screen);
+  if (analog_obj == NULL) {
+    ESP_LOGW(TAG, "Analog face unavailable");
+  }
+  scan_face_files();
+  lv_obj_add_event_cb(screen, face_long_pressed_cb, LV_EVENT_LONG_PRESSED,
+                      NULL);
+
+  apply_face();
+  event_manager_subscribe(EVENT_SYSTEM_AMBIENT_ENTER, ambient_event_callback, NULL);
+  event_manager_subscribe(EVENT_SYSTEM_AMBIENT_EXIT, ambient_event_callback, NULL);
+  event_manager_subscribe(EVENT_NOTIFICATION_NEW, notification_event_callback,
+                          NULL);
+  event_manager_subscribe(EVENT_NOTIFICATION_CLEAR,
+                          notification_event_callback, NULL);
+
+  ESP_LOGI(TAG, "Watchface screen created with %u primitives",
+           (unsigned)watchface_face.prim_count);
   return screen;
 }
 
@@ -289,6 +613,8 @@ static void watchface_app_on_show(void) {
   ESP_LOGI(TAG, "Watchface screen shown");
   navigation_manager_set_context(NAV_CONTEXT_WATCHFACE);
 
+  shown = true;
+
   // Get FRESH values from services
   struct tm time;
   time_service_get_time(&time);
@@ -300,6 +626,7 @@ static void watchface_app_on_show(void) {
   update_time_display(&time);
   update_battery_display();
   update_progress_display();
+  update_sweep();
   lvgl_port_unlock();
 
   // Subscribe to events (for updates while screen is shown)
@@ -311,6 +638,11 @@ static void watchface_app_on_show(void) {
 static void watchface_app_on_hide(void) {
   ESP_LOGI(TAG, "Watchface screen hidden");
 
+  shown = false;
+  lvgl_port_lock(-1);
+  update_sweep();
+  lvgl_port_unlock();
+
   // Unsubscribe from all events
   event_manager_unsubscribe(EVENT_TIME_UPDATED, time_event_callback);
   event_manager_unsubscribe(EVENT_BATTERY_UPDATED, battery_event_callback);
@@ -0,0 +1,371 @@
+#include "ui/asset_pack.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "rle565.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "asset_pack";
+
+#ifndef ASSET_PACK_CACHE_ENTRIES
+#define ASSET_PACK_CACHE_ENTRIES 8
+#endif
+#ifndef ASSET_PACK_CACHE_BYTES
+#define ASSET_PACK_CACHE_BYTES (32 * 1024)
+#endif
+
+#define ASSET_PARTITION "assets"
+#define STATS_LOG_INTERVAL 256 // Opens between cache logs
+
+// Pack layout (little endian, 4-byte aligned), see tools/asset_pack.py
+#define PACK_MAGIC "AST1"
+#define PACK_VERSION 1
+#define NAME_SIZE 24
+#define COMPRESS_NONE 0
+#define COMPRESS_RLE 1
+#define ATLAS_REGION 2 // No data: a rect of another (raw) asset
+
+typedef struct {
+  char magic[4];
+  uint16_t version;
+  uint16_t count;
+  uint32_t data_offset;
+  uint32_t total_size;
+} pack_header_t;
+
+typedef struct {
+  char name[NAME_SIZE]; // NUL-terminated, index sorted by name
+  uint32_t offset; // ATLAS_REGION: index of the atlas entry
+  uint32_t size;   // Stored bytes; ATLAS_REGION: y << 16 | x in the atlas
+  uint16_t w;
+  uint16_t h;
+  uint8_t cf; // LV_COLOR_FORMAT_RGB565 or _RGB565A8
+  uint8_t compression;
+  uint16_t reserved;
+} pack_entry_t;
+
+_Static_assert(sizeof(pack_header_t) == 16, "pack header size");
+_Static_assert(sizeof(pack_entry_t) == 40, "pack entry size");
+
+typedef struct {
+  const pack_entry_t *asset; // NULL = free slot
+  uint32_t last_used;
+  uint16_t refs;             // Open decoder descriptors using it
+  uint8_t *data;
+  lv_draw_buf_t buf;
+} decoded_entry_t;
+
+static const uint8_t *pack = NULL; // Mapped partition
+static const pack_entry_t *entries = NULL;
+static uint16_t entry_count = 0;
+static esp_partition_mmap_handle_t mmap_handle;
+
+static decoded_entry_t cache[ASSET_PACK_CACHE_ENTRIES];
+static uint32_t use_counter = 0;
+static asset_pack_stats_t stats;
+
+static uint32_t decoded_size(const pack_entry_t *asset) {
+  uint32_t pixels = (uint32_t)asset->w * asset->h;
+  return (asset->cf == LV_COLOR_FORMAT_RGB565A8) ? pixels * 3 : pixels * 2;
+}
+
+/**
+ * @brief Binary search the index for an ASSET_SRC() source
+ */
+static const pack_entry_t *find_asset(const void *src) {
+  if (entries == NULL || lv_image_src_get_type(src) != LV_IMAGE_SRC_FILE ||
+      strncmp(src, ASSET_SRC_PREFIX, strlen(ASSET_SRC_PREFIX)) != 0) {
+    return NULL;
+  }
+  const char *name = (const char *)src + strlen(ASSET_SRC_PREFIX);
+
+  uint32_t lo = 0;
+  uint32_t hi = entry_count;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    int cmp = strncmp(name, entries[mid].name, NAME_SIZE);
+    if (cmp == 0) {
+      return &entries[mid];
+    }
+    if (cmp > 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return NULL;
+}
+
+static void entry_release(decoded_entry_t *entry) {
+  stats.bytes_used -= decoded_size(entry->asset);
+  free(entry->data);
+  entry->data = NULL;
+  entry->asset = NULL;
+}
+
+/**
+ * @brief Free unused slots until one is empty and need bytes fit, oldest
+ * first
+ */
+static decoded_entry_t *cache_make_room(uint32_t need) {
+  decoded_entry_t *free_slot = NULL;
+  for (int i = 0; i < ASSET_PACK_CACHE_ENTRIES && free_slot == NULL; i++) {
+    if (cache[i].asset == NULL) {
+      free_slot = &cache[i];
+    }
+  }
+
+  while (free_slot == NULL || stats.bytes_used + need > ASSET_PACK_CACHE_BYTES) {
+    decoded_entry_t *lru = NULL;
+    for (int i = 0; i < ASSET_PACK_CACHE_ENTRIES; i++) {
+      if (cache[i].asset != NULL && cache[i].refs == 0 &&
+          (lru == NULL || cache[i].last_used < lru->last_used)) {
+        lru = &cache[i];
+      }
+    }
+    if (lru == NULL) {
+      return NULL; // Everything left is being drawn
+    }
+    entry_release(lru);
+    stats.evictions++;
+    if (free_slot == NULL) {
+      free_slot = lru;
+    }
+  }
+  return free_slot;
+}
+
+/**
+ * @brief Decoded copy of a compressed asset, decoding it on a miss
+ */
+static decoded_entry_t *decoded_get(const pack_entry_t *asset) {
+  for (int i = 0; i < ASSET_PACK_CACHE_ENTRIES; i++) {
+    if (cache[i].asset == asset) {
+      stats.hits++;
+      cache[i].last_used = ++use_counter;
+      return &cache[i];
+    }
+  }
+  stats.misses++;
+
+  uint32_t size = decoded_size(asset);
+  if (size > ASSET_PACK_CACHE_BYTES) {
+    ESP_LOGE(TAG, "%.*s needs %lu bytes, more than the cache", NAME_SIZE,
+             asset->name, (unsigned long)size);
+    return NULL;
+  }
+  decoded_entry_t *entry = cache_make_room(size);
+  if (entry == NULL) {
+    ESP_LOGW(TAG, "No room to decode %.*s", NAME_SIZE, asset->name);
+    return NULL;
+  }
+
+  // +1: the A8 plane is decoded as 16-bit pairs
+  uint8_t *data = malloc(size + 1);
+  if (data == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate %.*s", NAME_SIZE, asset->name);
+    return NULL;
+  }
+
+  uint32_t pixels = (uint32_t)asset->w * asset->h;
+  const uint8_t *in = pack + asset->offset;
+  size_t used = rle565_decode(in, asset->size, (uint16_t *)data, pixels);
+  if (used != 0 && asset->cf == LV_COLOR_FORMAT_RGB565A8) {
+    used = rle565_decode(in + used, asset->size - used,
+                         (uint16_t *)(data + pixels * 2), (pixels + 1) / 2);
+  }
+  if (used == 0) {
+    ESP_LOGE(TAG, "%.*s is corrupt", NAME_SIZE, asset->name);
+    free(data);
+    return NULL;
+  }
+
+  memset(entry, 0, sizeof(*entry));
+  entry->asset = asset;
+  entry->last_used = ++use_counter;
+  entry->data = data;
+  lv_draw_buf_init(&entry->buf, asset->w, asset->h, asset->cf, asset->w * 2,
+                   data, size);
+  stats.bytes_used += size;
+  return entry;
+}
+
+static lv_result_t asset_decoder_info(lv_image_decoder_t *decoder,
+                                      lv_image_decoder_dsc_t *dsc,
+                                      lv_image_header_t *header) {
+  const pack_entry_t *asset = find_asset(dsc->src);
+  if (asset == NULL || asset->compression == ATLAS_REGION) {
+    return LV_RESULT_INVALID;
+  }
+
+  header->magic = LV_IMAGE_HEADER_MAGIC;
+  header->cf = asset->cf;
+  header->w = asset->w;
+  header->h = asset->h;
+  header->stride = asset->w * 2; // RGB565 plane; A8 follows for RGB565A8
+  header->flags = 0;
+  return LV_RESULT_OK;
+}
+
+static lv_result_t asset_decoder_open(lv_image_decoder_t *decoder,
+                                      lv_image_decoder_dsc_t *dsc) {
+  const pack_entry_t *asset = find_asset(dsc->src);
+  if (asset == NULL || asset->compression == ATLAS_REGION) {
+    return LV_RESULT_INVALID;
+  }
+
+  stats.opens++;
+  if (stats.opens % STATS_LOG_INTERVAL == 0) {
+    ESP_LOGI(TAG, "Opens: %lu mapped, %lu hits, %lu decodes, %lu bytes",
+             (unsigned long)stats.mapped, (unsigned long)stats.hits,
+             (unsigned long)stats.misses, (unsigned long)stats.bytes_used);
+  }
+
+  if (asset->compression == COMPRESS_NONE) {
+    // Zero copy: the draw buffer points into the mapped partition
+    lv_draw_buf_t *buf = malloc(sizeof(lv_draw_buf_t));
+    if (buf == NULL) {
+      return LV_RESULT_INVALID;
+    }
+    lv_draw_buf_init(buf, asset->w, asset->h, asset->cf, asset->w * 2,
+                     (void *)(pack + asset->offset), decoded_size(asset));
+    stats.mapped++;
+    dsc->decoded = buf;
+    dsc->user_data = NULL;
+    return LV_RESULT_OK;
+  }
+
+  decoded_entry_t *entry = decoded_get(asset);
+  if (entry == NULL) {
+    return LV_RESULT_INVALID;
+  }
+  entry->refs++;
+  dsc->decoded = &entry->buf;
+  dsc->user_data = entry;
+  return LV_RESULT_OK;
+}
+
+static void asset_decoder_close(lv_image_decoder_t *decoder,
+                                lv_image_decoder_dsc_t *dsc) {
+  decoded_entry_t *entry = dsc->user_data;
+  if (entry != NULL) {
+    entry->refs--;
+  } else {
+    free((void *)dsc->decoded);
+  }
+  dsc->decoded = NULL;
+}
+
+/**
+ * @brief Check a region lies within a raw atlas of the same format
+ */
+static bool region_is_valid(const pack_entry_t *index, uint16_t count,
+                            const pack_entry_t *region) {
+  if (region->offset >= count) {
+    return false;
+  }
+  const pack_entry_t *atlas = &index[region->offset];
+  uint32_t x = region->size & 0xFFFF;
+  uint32_t y = region->size >> 16;
+  return atlas->compression == COMPRESS_NONE && atlas->cf == region->cf &&
+         x + region->w <= atlas->w && y + region->h <= atlas->h;
+}
+
+esp_err_t asset_pack_init(void) {
+  const esp_partition_t *part = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSET_PARTITION);
+  if (part == NULL) {
+    ESP_LOGE(TAG, "No %s partition", ASSET_PARTITION);
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  pack_header_t header;
+  esp_err_t ret = esp_partition_read(part, 0, &header, sizeof(header));
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to read pack header: %s", esp_err_to_name(ret));
+    return ret;
+  }
+  if (memcmp(header.magic, PACK_MAGIC, 4) != 0 ||
+      header.version != PACK_VERSION || header.total_size > part->size ||
+      header.data_offset !=
+          sizeof(pack_header_t) + header.count * sizeof(pack_entry_t) ||
+      header.data_offset > header.total_size) {
+    ESP_LOGW(TAG, "No asset pack in %s", ASSET_PARTITION);
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  const void *mapped = NULL;
+  ret = esp_partition_mmap(part, 0, header.total_size, ESP_PARTITION_MMAP_DATA,
+                           &mapped, &mmap_handle);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to map pack: %s", esp_err_to_name(ret));
+    return ret;
+  }
+
+  const pack_entry_t *index =
+      (const pack_entry_t *)((const uint8_t *)mapped + sizeof(pack_header_t));
+  for (uint16_t i = 0; i < header.count; i++) {
+    const pack_entry_t *asset = &index[i];
+    if (asset->compression == ATLAS_REGION) {
+      if (!region_is_valid(index, header.count, asset)) {
+        ESP_LOGE(TAG, "Asset %u is invalid", i);
+        esp_partition_munmap(mmap_handle);
+        return ESP_ERR_INVALID_RESPONSE;
+      }
+      continue;
+    }
+
+    uint32_t min_size = (asset->compression == COMPRESS_NONE)
+                            ? decoded_size(asset)
+                            : 1;
+    if (asset->offset % 4 != 0 || asset->offset < header.data_offset ||
+        asset->size < min_size ||
+        asset->size > header.total_size - asset->offset ||
+        (asset->cf != LV_COLOR_FORMAT_RGB565 &&
+         asset->cf != LV_COLOR_FORMAT_RGB565A8) ||
+        asset->compression > COMPRESS_RLE) {
+      ESP_LOGE(TAG, "Asset %u is invalid", i);
+      esp_partition_munmap(mmap_handle);
+      return ESP_ERR_INVALID_RESPONSE;
+    }
+  }
+
+  lv_image_decoder_t *decoder = lv_image_decoder_create();
+  if (decoder == NULL) {
+    esp_partition_munmap(mmap_handle);
+    return ESP_ERR_NO_MEM;
+  }
+  decoder->name = "ASSET";
+  lv_image_decoder_set_info_cb(decoder, asset_decoder_info);
+  lv_image_decoder_set_open_cb(decoder, asset_decoder_open);
+  lv_image_decoder_set_close_cb(decoder, asset_decoder_close);
+
+  pack = mapped;
+  entries = index;
+  entry_count = header.count;
+  ESP_LOGI(TAG, "Mapped %u assets (%lu bytes)", entry_count,
+           (unsigned long)header.total_size);
+  return ESP_OK;
+}
+
+bool asset_pack_has(const void *src) {
+  const pack_entry_t *asset = (src != NULL) ? find_asset(src) : NULL;
+  return asset != NULL && asset->compression != ATLAS_REGION;
+}
+
+bool asset_pack_get_region(const void *src, const void *atlas,
+                           lv_area_t *area) {
+  const pack_entry_t *region = (src != NULL) ? find_asset(src) : NULL;
+  if (region == NULL || region->compression != ATLAS_REGION ||
+      find_asset(atlas) != &entries[region->offset]) {
+    return false;
+  }
+
+  area->x1 = region->size & 0xFFFF;
+  area->y1 = region->size >> 16;
+  area->x2 = area->x1 + region->w - 1;
+  area->y2 = area->y1 + region->h - 1;
+  return true;
+}
+
+void asset_pack_get_stats(asset_pack_stats_t *out) { *out = stats; }
@@ -0,0 +1,65 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief LVGL image source for a packed asset
+ *
+ * Usable wherever LVGL takes an image source, e.g.
+ * lv_image_set_src(img, ASSET_SRC("app_sysinfo")).
+ */
+#define ASSET_SRC_PREFIX "asset:"
+#define ASSET_SRC(name) ASSET_SRC_PREFIX name
+
+/**
+ * @brief Decoded image cache statistics
+ */
+typedef struct {
+  uint32_t opens;
+  uint32_t mapped;    // Raw assets drawn in place from flash
+  uint32_t hits;      // Compressed assets found decoded
+  uint32_t misses;    // Compressed assets decoded
+  uint32_t evictions;
+  uint32_t bytes_used;
+} asset_pack_stats_t;
+
+/**
+ * @brief Map the asset pack and register its image decoder
+ *
+ * The pack (tools/asset_pack.py) lives in the "assets" partition, which is
+ * memory-mapped: raw assets are drawn straight from flash and compressed
+ * ones are decoded into a small LRU cache. Call with the LVGL lock held.
+ */
+esp_err_t asset_pack_init(void);
+
+/**
+ * @brief Check if an ASSET_SRC() source is in the pack
+ *
+ * Atlas regions are not images of their own, see asset_pack_get_region().
+ */
+bool asset_pack_has(const void *src);
+
+/**
+ * @brief Look up an image packed into an atlas (asset_pack.py --atlas)
+ *
+ * The region is drawn by drawing atlas clipped to the region's rect, so
+ * any number of such images share one texture mapped from flash.
+ *
+ * @param src ASSET_SRC() of the packed image
+ * @param atlas ASSET_SRC() of the atlas
+ * @param area Set to the image's rect within the atlas
+ * @return true if src is a region of atlas
+ */
+bool asset_pack_get_region(const void *src, const void *atlas,
+                           lv_area_t *area);
+
+/**
+ * @brief Get decoded image cache statistics
+ */
+void asset_pack_get_stats(asset_pack_stats_t *stats);
+
+#endif // ASSET_PACK_H
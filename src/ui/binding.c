@@ -0,0 +1,68 @@
+#include "ui/binding.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+
+static const char *TAG = "binding";
+
+#define REPORT_PERIOD_US (60 * 1000 * 1000LL)
+
+static binding_stats_t stats;
+static uint32_t window_redundant = 0;
+static uint32_t window_applied = 0;
+static int64_t window_start_us = 0;
+
+static void report_window(void) {
+  int64_t now = esp_timer_get_time();
+  if (window_start_us == 0) {
+    window_start_us = now;
+    return;
+  }
+  if (now - window_start_us < REPORT_PERIOD_US) {
+    return;
+  }
+
+  stats.redundant_last_minute = window_redundant;
+  ESP_LOGI(TAG, "Last minute: %lu applied, %lu redundant updates skipped",
+           (unsigned long)window_applied, (unsigned long)window_redundant);
+  window_redundant = 0;
+  window_applied = 0;
+  window_start_us = now;
+}
+
+bool binding_update(binding_t *binding, const void *model) {
+  stats.updates++;
+  report_window();
+
+  int32_t value = binding->map(model);
+  if (binding->applied && value == binding->last_value) {
+    stats.redundant++;
+    window_redundant++;
+    return false;
+  }
+
+  char text[BINDING_TEXT_MAX];
+  if (binding->format != NULL) {
+    binding->format(model, text, sizeof(text));
+    if (binding->applied && strcmp(text, binding->last_text) == 0) {
+      binding->last_value = value; // Key moved, text did not
+      stats.redundant++;
+      window_redundant++;
+      return false;
+    }
+    strcpy(binding->last_text, text);
+  }
+
+  binding->last_value = value;
+  binding->applied = true;
+  binding->apply(binding, value, binding->format != NULL ? text : NULL);
+
+  stats.applied++;
+  window_applied++;
+  ESP_LOGD(TAG, "%s -> %ld", binding->name, (long)value);
+  return true;
+}
+
+void binding_reset(binding_t *binding) { binding->applied = false; }
+
+void binding_get_stats(binding_stats_t *out) { *out = stats; }
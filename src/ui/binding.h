@@ -0,0 +1,81 @@
+#ifndef BINDING_H
+#define BINDING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BINDING_TEXT_MAX 24
+
+typedef struct binding binding_t;
+
+/**
+ * @brief Reduce a model value to what the view depends on
+ *
+ * Cheap: runs on every update. For text bindings this is a key (e.g. the
+ * minute of day) so formatting only runs when the key moves.
+ */
+typedef int32_t (*binding_map_cb_t)(const void *model);
+
+/**
+ * @brief Format a model value into text (optional)
+ */
+typedef void (*binding_format_cb_t)(const void *model, char *out, size_t size);
+
+/**
+ * @brief Push a changed value into LVGL
+ *
+ * text is NULL for bindings without a formatter.
+ */
+typedef void (*binding_apply_cb_t)(const binding_t *binding, int32_t value,
+                                   const char *text);
+
+/**
+ * @brief Model-to-view binding with change detection
+ */
+struct binding {
+  const char *name;
+  binding_map_cb_t map;
+  binding_format_cb_t format;
+  binding_apply_cb_t apply;
+  void *target; // For apply (usually an lv_obj_t)
+  uint8_t slot; // For apply
+
+  // State
+  bool applied;
+  int32_t last_value;
+  char last_text[BINDING_TEXT_MAX];
+};
+
+/**
+ * @brief Binding statistics (all bindings)
+ */
+typedef struct {
+  uint32_t updates;   // Model updates seen
+  uint32_t applied;   // Updates that reached LVGL
+  uint32_t redundant; // Updates dropped as unchanged
+  uint32_t redundant_last_minute;
+} binding_stats_t;
+
+/**
+ * @brief Feed a new model value through the binding
+ *
+ * Only calls apply (and so only touches LVGL) when the mapped value or
+ * the formatted text differs from the last applied one. Redundant
+ * updates are counted and reported once a minute. Must hold the LVGL lock.
+ *
+ * @return true if the view was updated
+ */
+bool binding_update(binding_t *binding, const void *model);
+
+/**
+ * @brief Forget the last applied value so the next update always applies
+ */
+void binding_reset(binding_t *binding);
+
+/**
+ * @brief Get binding statistics
+ */
+void binding_get_stats(binding_stats_t *stats);
+
+#endif // BINDING_H
@@ -0,0 +1,181 @@
+#include "ui/digit_atlas.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "digit_atlas";
+
+typedef struct {
+  const digit_atlas_t *atlas;
+  char text[2];
+  lv_color_t fg;
+  lv_color_t bg;
+} sprite_render_ctx_t;
+
+static int atlas_index(char c) {
+  const char *pos = (c != '\0') ? strchr(DIGIT_ATLAS_CHARS, c) : NULL;
+  return (pos != NULL) ? (int)(pos - DIGIT_ATLAS_CHARS) : -1;
+}
+
+static void render_sprite_cb(lv_layer_t *layer, int32_t x, int32_t y,
+                             void *user_data) {
+  const sprite_render_ctx_t *ctx = user_data;
+
+  lv_draw_rect_dsc_t bg;
+  lv_draw_rect_dsc_init(&bg);
+  bg.bg_color = ctx->bg;
+  lv_draw_rect(layer, &bg, &layer->buf_area);
+
+  lv_draw_label_dsc_t dsc;
+  lv_draw_label_dsc_init(&dsc);
+  dsc.font = ctx->atlas->font;
+  dsc.color = ctx->fg;
+  dsc.text = ctx->text;
+  dsc.text_local = true;
+
+  // Line box shifted up so its ink rows land on the sprite
+  lv_area_t area = {x, y - ctx->atlas->top, x + layer->buf_area.x2 + 8,
+                    y - ctx->atlas->top + lv_font_get_line_height(dsc.font)};
+  lv_draw_label(layer, &dsc, &area);
+}
+
+uint32_t digit_atlas_key(lv_color_t fg, lv_color_t bg) {
+  return (lv_color_to_u32(fg) * 31) ^ lv_color_to_u32(bg);
+}
+
+int32_t digit_atlas_char_width(const lv_font_t *font, char c) {
+  return lv_font_get_glyph_width(font, (uint32_t)c, 0);
+}
+
+/**
+ * @brief Pen position of character count, as the atlas or a label places it
+ */
+static int32_t prefix_width(const lv_font_t *font, const char *text,
+                            size_t count, bool kerned) {
+  int32_t width = 0;
+  for (size_t c = 0; c < count; c++) {
+    width += lv_font_get_glyph_width(font, (uint8_t)text[c],
+                                     kerned ? (uint8_t)text[c + 1] : 0);
+  }
+  return width;
+}
+
+/**
+ * @brief How far a glyph's ink reaches left of its pen position (<= 0)
+ */
+static int32_t left_overhang(const lv_font_t *font, const char *text) {
+  lv_font_glyph_dsc_t glyph;
+  if (text[0] == '\0' ||
+      !lv_font_get_glyph_dsc(font, &glyph, (uint8_t)text[0],
+                             (uint8_t)text[1])) {
+    return 0;
+  }
+  return LV_MIN(glyph.ofs_x, 0);
+}
+
+int32_t digit_atlas_change_x(const lv_font_t *font, const char *old_text,
+                             const char *new_text, size_t same) {
+  for (const char *t = old_text; *t != '\0'; t++) {
+    if ((uint8_t)*t >= 0x80) {
+      return 0; // Byte widths would be wrong for UTF-8
+    }
+  }
+  for (const char *t = new_text; *t != '\0'; t++) {
+    if ((uint8_t)*t >= 0x80) {
+      return 0;
+    }
+  }
+
+  // The kerning of the last unchanged character depends on the next one
+  int32_t x = prefix_width(font, new_text, same, false);
+  x = LV_MIN(x, prefix_width(font, old_text, same, true));
+  x = LV_MIN(x, prefix_width(font, new_text, same, true));
+  x += LV_MIN(left_overhang(font, old_text + same),
+              left_overhang(font, new_text + same));
+  return LV_MAX(x, 0);
+}
+
+esp_err_t digit_atlas_init(digit_atlas_t *atlas, const lv_font_t *font,
+                           lv_color_t fg, lv_color_t bg) {
+  // Ink extent of all characters within the line box
+  int32_t ascent = font->line_height - font->base_line;
+  int32_t top = font->line_height;
+  int32_t bottom = 0;
+  for (size_t i = 0; i < DIGIT_ATLAS_COUNT; i++) {
+    lv_font_glyph_dsc_t glyph;
+    if (!lv_font_get_glyph_dsc(font, &glyph, DIGIT_ATLAS_CHARS[i], 0)) {
+      ESP_LOGE(TAG, "Font lacks '%c'", DIGIT_ATLAS_CHARS[i]);
+      return ESP_ERR_NOT_FOUND;
+    }
+    int32_t glyph_top = ascent - glyph.box_h - glyph.ofs_y;
+    top = LV_MIN(top, glyph_top);
+    bottom = LV_MAX(bottom, glyph_top + glyph.box_h);
+  }
+  top = LV_MAX(top - 1, 0); // Room for antialiasing rounding
+  bottom = LV_MIN(bottom + 1, (int32_t)font->line_height);
+
+  // Re-render in place if only the colours changed
+  if (atlas->font != font || atlas->top != top) {
+    digit_atlas_deinit(atlas);
+  }
+  atlas->font = font;
+  atlas->top = top;
+  atlas->height = bottom - top;
+
+  uint32_t key = digit_atlas_key(fg, bg);
+  sprite_render_ctx_t ctx = {.atlas = atlas, .fg = fg, .bg = bg};
+  uint32_t bytes = 0;
+  for (size_t i = 0; i < DIGIT_ATLAS_COUNT; i++) {
+    layer_cache_t *sprite = &atlas->sprites[i];
+    if (sprite->data == NULL) {
+      lv_area_t area = {0, 0,
+                        digit_atlas_char_width(font, DIGIT_ATLAS_CHARS[i]) - 1,
+                        atlas->height - 1};
+      layer_cache_init(sprite, &area);
+    }
+    ctx.text[0] = DIGIT_ATLAS_CHARS[i];
+    esp_err_t ret = layer_cache_render(sprite, key, render_sprite_cb, &ctx);
+    if (ret != ESP_OK) {
+      digit_atlas_deinit(atlas);
+      return ret;
+    }
+    bytes += sprite->buf.data_size;
+  }
+
+  atlas->key = key;
+  ESP_LOGI(TAG, "Rendered %u sprites, %ld px high (%lu bytes)",
+           (unsigned)DIGIT_ATLAS_COUNT, (long)atlas->height,
+           (unsigned long)bytes);
+  return ESP_OK;
+}
+
+bool digit_atlas_matches(const digit_atlas_t *atlas, const lv_font_t *font,
+                         uint32_t key) {
+  return atlas->font == font && atlas->key == key &&
+         atlas->sprites[0].valid;
+}
+
+bool digit_atlas_covers(const char *text) {
+  for (; *text != '\0'; text++) {
+    if (atlas_index(*text) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void digit_atlas_draw(digit_atlas_t *atlas, lv_layer_t *layer,
+                      const char *text, int32_t x, int32_t y) {
+  for (; *text != '\0'; text++) {
+    layer_cache_t *sprite = &atlas->sprites[atlas_index(*text)];
+    layer_cache_draw(sprite, layer, x, y + atlas->top, atlas->key);
+    x += lv_area_get_width(&sprite->area);
+  }
+}
+
+void digit_atlas_deinit(digit_atlas_t *atlas) {
+  for (size_t i = 0; i < DIGIT_ATLAS_COUNT; i++) {
+    layer_cache_deinit(&atlas->sprites[i]);
+  }
+  atlas->font = NULL;
+  atlas->key = 0;
+}
@@ -0,0 +1,80 @@
+#ifndef DIGIT_ATLAS_H
+#define DIGIT_ATLAS_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+#include "ui/layer_cache.h"
+#include <stdbool.h>
+
+#define DIGIT_ATLAS_CHARS "0123456789:"
+#define DIGIT_ATLAS_COUNT (sizeof(DIGIT_ATLAS_CHARS) - 1)
+
+/**
+ * @brief Pre-rasterised RGB565 sprites of the clock characters
+ *
+ * Each character is rendered once with fixed colours into an opaque
+ * sprite one advance wide and as tall as the digits' ink. Drawing a
+ * string is then one image copy per character instead of rasterising
+ * the font's glyph bitmaps.
+ */
+typedef struct {
+  const lv_font_t *font;
+  uint32_t key;    // Colours the sprites were rendered with
+  int32_t top;     // First ink row below the top of the line box
+  int32_t height;  // Sprite height
+  layer_cache_t sprites[DIGIT_ATLAS_COUNT];
+} digit_atlas_t;
+
+/**
+ * @brief Key for a colour pair, to compare with digit_atlas_t.key
+ */
+uint32_t digit_atlas_key(lv_color_t fg, lv_color_t bg);
+
+/**
+ * @brief Render the sprites (not from a draw event)
+ */
+esp_err_t digit_atlas_init(digit_atlas_t *atlas, const lv_font_t *font,
+                           lv_color_t fg, lv_color_t bg);
+
+/**
+ * @brief Whether the atlas can draw text in this font and colours
+ */
+bool digit_atlas_matches(const digit_atlas_t *atlas, const lv_font_t *font,
+                         uint32_t key);
+
+/**
+ * @brief Whether every character of text is in the atlas
+ */
+bool digit_atlas_covers(const char *text);
+
+/**
+ * @brief Advance width of a character, as a label would lay it out
+ */
+int32_t digit_atlas_char_width(const lv_font_t *font, char c);
+
+/**
+ * @brief Left edge of the first character that differs, for a redraw
+ *
+ * old_text and new_text agree on the first same characters. The result
+ * (relative to the start of the line box) is safe whether the text is
+ * drawn from the atlas (no kerning) or as a label (kerned, glyphs may
+ * overhang to the left). 0 for non-ASCII text.
+ */
+int32_t digit_atlas_change_x(const lv_font_t *font, const char *old_text,
+                             const char *new_text, size_t same);
+
+/**
+ * @brief Draw text with the top-left of its line box at x/y
+ *
+ * The caller checks digit_atlas_matches() and digit_atlas_covers() first.
+ * Only the ink rows are drawn; the rest of the line box is left as is.
+ */
+void digit_atlas_draw(digit_atlas_t *atlas, lv_layer_t *layer,
+                      const char *text, int32_t x, int32_t y);
+
+/**
+ * @brief Free the sprites
+ */
+void digit_atlas_deinit(digit_atlas_t *atlas);
+
+#endif // DIGIT_ATLAS_H
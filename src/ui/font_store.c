@@ -0,0 +1,285 @@
+#include "ui/font_store.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "font_store";
+
+#ifndef FONT_STORE_CACHE_GLYPHS
+#define FONT_STORE_CACHE_GLYPHS 128
+#endif
+#ifndef FONT_STORE_CACHE_BYTES
+#define FONT_STORE_CACHE_BYTES (16 * 1024)
+#endif
+
+#define STATS_LOG_INTERVAL 4096 // Lookups between hit rate logs
+
+// File layout (little endian), see tools/font_pack.py
+#define FILE_MAGIC "WFN1"
+#define HEADER_SIZE 16
+#define INDEX_SIZE 16
+
+typedef struct {
+  lv_font_t font; // First, so the lv_font_t pointer is the store font
+  FILE *file;
+  uint32_t glyph_count;
+} store_font_t;
+
+typedef struct {
+  const store_font_t *font; // NULL = free slot
+  uint32_t codepoint;
+  uint32_t last_used;
+  uint16_t adv_w;
+  uint8_t box_w;
+  uint8_t box_h;
+  int8_t ofs_x;
+  int8_t ofs_y;
+  bool missing;    // Not in the file: ask the fallback
+  uint8_t *bitmap; // 4 bpp, rows padded to a byte
+} glyph_entry_t;
+
+static glyph_entry_t cache[FONT_STORE_CACHE_GLYPHS];
+static uint32_t use_counter = 0;
+static font_store_stats_t stats;
+
+static uint32_t read_u32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+static uint32_t bitmap_size(uint8_t box_w, uint8_t box_h) {
+  return ((box_w + 1) / 2) * box_h;
+}
+
+static void entry_release(glyph_entry_t *entry) {
+  if (entry->bitmap != NULL) {
+    stats.bytes_used -= bitmap_size(entry->box_w, entry->box_h);
+    free(entry->bitmap);
+    entry->bitmap = NULL;
+  }
+  entry->font = NULL;
+}
+
+static glyph_entry_t *cache_find(const store_font_t *font, uint32_t codepoint) {
+  for (int i = 0; i < FONT_STORE_CACHE_GLYPHS; i++) {
+    if (cache[i].font == font && cache[i].codepoint == codepoint) {
+      return &cache[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Free slots until one is empty and need bytes fit, oldest first
+ */
+static glyph_entry_t *cache_make_room(uint32_t need) {
+  glyph_entry_t *free_slot = NULL;
+  for (int i = 0; i < FONT_STORE_CACHE_GLYPHS && free_slot == NULL; i++) {
+    if (cache[i].font == NULL) {
+      free_slot = &cache[i];
+    }
+  }
+
+  while (free_slot == NULL || stats.bytes_used + need > FONT_STORE_CACHE_BYTES) {
+    glyph_entry_t *lru = NULL;
+    for (int i = 0; i < FONT_STORE_CACHE_GLYPHS; i++) {
+      if (cache[i].font != NULL &&
+          (lru == NULL || cache[i].last_used < lru->last_used)) {
+        lru = &cache[i];
+      }
+    }
+    if (lru == NULL) {
+      break; // Empty cache and the glyph is bigger than all of it
+    }
+    entry_release(lru);
+    stats.evictions++;
+    if (free_slot == NULL) {
+      free_slot = lru;
+    }
+  }
+  return free_slot;
+}
+
+/**
+ * @brief Binary search the file's index for a code point
+ */
+static bool index_find(const store_font_t *font, uint32_t codepoint,
+                       uint8_t *record) {
+  uint32_t lo = 0;
+  uint32_t hi = font->glyph_count;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (fseek(font->file, HEADER_SIZE + mid * INDEX_SIZE, SEEK_SET) != 0 ||
+        fread(record, INDEX_SIZE, 1, font->file) != 1) {
+      return false;
+    }
+    uint32_t cp = read_u32(record);
+    if (cp == codepoint) {
+      return true;
+    }
+    if (cp < codepoint) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Cached entry for a glyph, reading it from the file on a miss
+ */
+static glyph_entry_t *glyph_get(const store_font_t *font, uint32_t codepoint) {
+  stats.lookups++;
+  if (stats.lookups % STATS_LOG_INTERVAL == 0) {
+    ESP_LOGI(TAG, "Glyph cache: %lu%% hits, %lu evictions, %lu bytes",
+             (unsigned long)(stats.hits * 100 / stats.lookups),
+             (unsigned long)stats.evictions, (unsigned long)stats.bytes_used);
+  }
+
+  glyph_entry_t *entry = cache_find(font, codepoint);
+  if (entry != NULL) {
+    stats.hits++;
+    entry->last_used = ++use_counter;
+    return entry;
+  }
+  stats.misses++;
+
+  uint8_t record[INDEX_SIZE];
+  bool found = index_find(font, codepoint, record);
+  uint32_t size = found ? bitmap_size(record[10], record[11]) : 0;
+
+  entry = cache_make_room(size);
+  if (entry == NULL) {
+    return NULL;
+  }
+  memset(entry, 0, sizeof(*entry));
+  entry->font = font;
+  entry->codepoint = codepoint;
+  entry->last_used = ++use_counter;
+  entry->missing = !found;
+  if (!found) {
+    return entry;
+  }
+
+  entry->adv_w = read_u16(&record[8]);
+  entry->box_w = record[10];
+  entry->box_h = record[11];
+  entry->ofs_x = (int8_t)record[12];
+  entry->ofs_y = (int8_t)record[13];
+  if (size == 0) {
+    return entry; // Blank glyph such as a space
+  }
+
+  entry->bitmap = malloc(size);
+  if (entry->bitmap == NULL ||
+      fseek(font->file, read_u32(&record[4]), SEEK_SET) != 0 ||
+      fread(entry->bitmap, size, 1, font->file) != 1) {
+    ESP_LOGE(TAG, "Failed to load U+%04lX", (unsigned long)codepoint);
+    free(entry->bitmap);
+    entry->bitmap = NULL;
+    entry->font = NULL;
+    return NULL;
+  }
+  stats.bytes_used += size;
+  return entry;
+}
+
+static bool store_get_glyph_dsc(const lv_font_t *font,
+                                lv_font_glyph_dsc_t *dsc, uint32_t letter,
+                                uint32_t letter_next) {
+  const store_font_t *store = (const store_font_t *)font;
+  glyph_entry_t *entry = glyph_get(store, letter);
+  if (entry == NULL || entry->missing) {
+    return false;
+  }
+
+  dsc->adv_w = entry->adv_w;
+  dsc->box_w = entry->box_w;
+  dsc->box_h = entry->box_h;
+  dsc->ofs_x = entry->ofs_x;
+  dsc->ofs_y = entry->ofs_y;
+  dsc->format = LV_FONT_GLYPH_FORMAT_A8; // Expanded in get_glyph_bitmap
+  dsc->is_placeholder = false;
+  dsc->gid.index = letter;
+  return true;
+}
+
+static const void *store_get_glyph_bitmap(lv_font_glyph_dsc_t *dsc,
+                                          lv_draw_buf_t *draw_buf) {
+  const store_font_t *store = (const store_font_t *)dsc->resolved_font;
+  glyph_entry_t *entry = glyph_get(store, dsc->gid.index);
+  if (entry == NULL || entry->bitmap == NULL) {
+    return NULL;
+  }
+
+  // 4 bpp to A8
+  uint32_t src_stride = (entry->box_w + 1) / 2;
+  for (uint32_t y = 0; y < entry->box_h; y++) {
+    const uint8_t *src = entry->bitmap + y * src_stride;
+    uint8_t *dst = draw_buf->data + y * draw_buf->header.stride;
+    for (uint32_t x = 0; x < entry->box_w; x++) {
+      uint8_t nibble = (x & 1) ? (src[x / 2] & 0x0F) : (src[x / 2] >> 4);
+      dst[x] = nibble * 17;
+    }
+  }
+  return draw_buf;
+}
+
+const lv_font_t *font_store_open(const char *path, const lv_font_t *fallback) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    ESP_LOGW(TAG, "No font file %s", path);
+    return NULL;
+  }
+
+  uint8_t header[HEADER_SIZE];
+  if (fread(header, sizeof(header), 1, file) != 1 ||
+      memcmp(header, FILE_MAGIC, 4) != 0 || header[10] != 4) {
+    ESP_LOGE(TAG, "%s is not a 4 bpp font file", path);
+    fclose(file);
+    return NULL;
+  }
+
+  store_font_t *store = calloc(1, sizeof(store_font_t));
+  if (store == NULL) {
+    fclose(file);
+    return NULL;
+  }
+  store->file = file;
+  store->glyph_count = read_u32(&header[12]);
+
+  lv_font_t *font = &store->font;
+  font->get_glyph_dsc = store_get_glyph_dsc;
+  font->get_glyph_bitmap = store_get_glyph_bitmap;
+  font->line_height = read_u16(&header[4]);
+  font->base_line = read_u16(&header[6]);
+  font->underline_position = (int8_t)header[8];
+  font->underline_thickness = header[9];
+  font->subpx = LV_FONT_SUBPX_NONE;
+  font->fallback = fallback;
+  font->dsc = store;
+
+  ESP_LOGI(TAG, "Opened %s: %lu glyphs, %d px line", path,
+           (unsigned long)store->glyph_count, font->line_height);
+  return font;
+}
+
+void font_store_close(const lv_font_t *font) {
+  store_font_t *store = (store_font_t *)font;
+  if (store == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < FONT_STORE_CACHE_GLYPHS; i++) {
+    if (cache[i].font == store) {
+      entry_release(&cache[i]);
+    }
+  }
+  fclose(store->file);
+  free(store);
+}
+
+void font_store_get_stats(font_store_stats_t *out) { *out = stats; }
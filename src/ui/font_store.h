@@ -0,0 +1,40 @@
+#ifndef FONT_STORE_H
+#define FONT_STORE_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+/**
+ * @brief Glyph cache statistics (all store fonts)
+ */
+typedef struct {
+  uint32_t lookups;
+  uint32_t hits;
+  uint32_t misses;    // Glyphs read from storage
+  uint32_t evictions;
+  uint32_t bytes_used; // Bitmap bytes cached
+} font_store_stats_t;
+
+/**
+ * @brief Open a font packed with tools/font_pack.py
+ *
+ * Glyphs are streamed from the file on first use and kept in a shared,
+ * fixed-size LRU cache, so a font covering thousands of code points costs
+ * no flash and only the cache in RAM. Characters missing from the file
+ * are taken from fallback (may be NULL).
+ *
+ * @return The font, or NULL if the file is missing or invalid
+ */
+const lv_font_t *font_store_open(const char *path, const lv_font_t *fallback);
+
+/**
+ * @brief Close a font and drop its cached glyphs
+ */
+void font_store_close(const lv_font_t *font);
+
+/**
+ * @brief Get glyph cache statistics
+ */
+void font_store_get_stats(font_store_stats_t *stats);
+
+#endif // FONT_STORE_H
@@ -0,0 +1,85 @@
+#include "ui/layer_cache.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+static const char *TAG = "layer_cache";
+
+void layer_cache_init(layer_cache_t *cache, const lv_area_t *area) {
+  cache->area = *area;
+  cache->data = NULL;
+  cache->key = 0;
+  cache->valid = false;
+}
+
+esp_err_t layer_cache_render(layer_cache_t *cache, uint32_t key,
+                             layer_cache_render_cb_t render_cb,
+                             void *user_data) {
+  int32_t w = lv_area_get_width(&cache->area);
+  int32_t h = lv_area_get_height(&cache->area);
+  uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+
+  if (cache->data == NULL) {
+    cache->data = malloc(stride * h);
+    if (cache->data == NULL) {
+      ESP_LOGE(TAG, "Failed to allocate %ldx%ld layer", (long)w, (long)h);
+      return ESP_ERR_NO_MEM;
+    }
+    lv_draw_buf_init(&cache->buf, w, h, LV_COLOR_FORMAT_RGB565, stride,
+                     cache->data, stride * h);
+  } else {
+    lv_image_cache_drop(&cache->buf); // Pixels change in place
+  }
+
+  lv_area_t buf_area = {0, 0, w - 1, h - 1};
+  lv_layer_t layer;
+  lv_layer_init(&layer);
+  layer.draw_buf = &cache->buf;
+  layer.color_format = LV_COLOR_FORMAT_RGB565;
+  layer.buf_area = buf_area;
+  layer._clip_area = buf_area;
+  layer.phy_clip_area = buf_area;
+
+  render_cb(&layer, -cache->area.x1, -cache->area.y1, user_data);
+
+  // Same loop as lv_canvas_finish_layer()
+  while (layer.draw_task_head != NULL) {
+    lv_draw_dispatch_wait_for_request();
+    if (!lv_draw_dispatch_layer(lv_display_get_default(), &layer)) {
+      lv_draw_wait_for_finish();
+      lv_draw_dispatch_request();
+    }
+  }
+
+  cache->key = key;
+  cache->valid = true;
+  ESP_LOGD(TAG, "Rendered %ldx%ld layer (%lu bytes)", (long)w, (long)h,
+           (unsigned long)(stride * h));
+  return ESP_OK;
+}
+
+bool layer_cache_draw(layer_cache_t *cache, lv_layer_t *layer, int32_t x,
+                      int32_t y, uint32_t key) {
+  if (!cache->valid || cache->key != key) {
+    return false;
+  }
+
+  lv_area_t area = cache->area;
+  lv_area_move(&area, x, y);
+
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+  dsc.src = &cache->buf;
+  lv_draw_image(layer, &dsc, &area);
+  return true;
+}
+
+void layer_cache_invalidate(layer_cache_t *cache) { cache->valid = false; }
+
+void layer_cache_deinit(layer_cache_t *cache) {
+  if (cache->data != NULL) {
+    lv_image_cache_drop(&cache->buf);
+    free(cache->data);
+    cache->data = NULL;
+  }
+  cache->valid = false;
+}
@@ -0,0 +1,66 @@
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Draws the static content of a cached area
+ *
+ * x/y is where the owning object's origin lies in the layer; draw with the
+ * same object-relative coordinates used for direct drawing.
+ */
+typedef void (*layer_cache_render_cb_t)(lv_layer_t *layer, int32_t x,
+                                        int32_t y, void *user_data);
+
+/**
+ * @brief Retained RGB565 image of a static, opaque part of an object
+ *
+ * Pays off where static content is redrawn around changing content, as on
+ * the watchfaces. The system screens don't use it: their static parts
+ * only redraw on a screen load, and the lists scroll in hardware.
+ */
+typedef struct {
+  lv_area_t area; // Relative to the owning object
+  lv_draw_buf_t buf;
+  uint8_t *data;
+  uint32_t key; // Theme/layout the image was rendered for
+  bool valid;
+} layer_cache_t;
+
+/**
+ * @brief Set up a cache for an object-relative area (nothing allocated yet)
+ */
+void layer_cache_init(layer_cache_t *cache, const lv_area_t *area);
+
+/**
+ * @brief Render the area into the retained image
+ *
+ * Must not be called from a draw event: it runs its own draw pass.
+ */
+esp_err_t layer_cache_render(layer_cache_t *cache, uint32_t key,
+                             layer_cache_render_cb_t render_cb,
+                             void *user_data);
+
+/**
+ * @brief Draw the retained image with the owner's origin at x/y
+ *
+ * @return false if the image is missing or was rendered for another key;
+ *         the caller then draws directly and re-renders later
+ */
+bool layer_cache_draw(layer_cache_t *cache, lv_layer_t *layer, int32_t x,
+                      int32_t y, uint32_t key);
+
+/**
+ * @brief Mark the image stale (keeps the buffer for the next render)
+ */
+void layer_cache_invalidate(layer_cache_t *cache);
+
+/**
+ * @brief Free the retained image
+ */
+void layer_cache_deinit(layer_cache_t *cache);
+
+#endif // LAYER_CACHE_H
@@ -0,0 +1,154 @@
+#include "ui/overlay_layer.h"
+#include "aa_mask.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+static const char *TAG = "overlay_layer";
+
+typedef struct {
+  lv_draw_buf_t buf; // RGB565 plane followed by the A8 plane
+  uint8_t *data;
+  lv_obj_t *source; // Hidden child the image is rendered from
+} overlay_t;
+
+static void overlay_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  overlay_t *overlay = lv_obj_get_user_data(obj);
+
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+    lv_image_cache_drop(&overlay->buf);
+    free(overlay->data);
+    free(overlay);
+    return;
+  }
+
+  // LV_EVENT_DRAW_MAIN
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+  dsc.src = &overlay->buf;
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_draw_image(lv_event_get_layer(e), &dsc, &coords);
+}
+
+/**
+ * @brief Render obj into the RGB565 plane
+ *
+ * The plane is first filled with obj's background colour, so a translucent
+ * background keeps its colour; the opacity goes to the alpha plane.
+ */
+static void render_color(lv_obj_t *obj, uint8_t *data, int32_t w, int32_t h) {
+  uint16_t fill = lv_color_to_u16(lv_obj_get_style_bg_color(obj, 0));
+  uint16_t *px = (uint16_t *)data;
+  for (int32_t i = 0; i < w * h; i++) {
+    px[i] = fill;
+  }
+
+  lv_draw_buf_t target;
+  uint32_t stride = w * sizeof(uint16_t);
+  lv_draw_buf_init(&target, w, h, LV_COLOR_FORMAT_RGB565, stride, data,
+                   stride * h);
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_layer_t layer;
+  lv_layer_init(&layer);
+  layer.draw_buf = &target;
+  layer.color_format = LV_COLOR_FORMAT_RGB565;
+  layer.buf_area = coords;
+  layer._clip_area = coords;
+  layer.phy_clip_area = coords;
+
+  lv_obj_redraw(&layer, obj);
+
+  // Same loop as lv_canvas_finish_layer()
+  while (layer.draw_task_head != NULL) {
+    lv_draw_dispatch_wait_for_request();
+    if (!lv_draw_dispatch_layer(lv_display_get_default(), &layer)) {
+      lv_draw_wait_for_finish();
+      lv_draw_dispatch_request();
+    }
+  }
+}
+
+/**
+ * @brief Build the A8 plane: the rounded outline at the background opacity
+ */
+static void render_alpha(lv_obj_t *obj, uint8_t *alpha, int32_t w, int32_t h) {
+  aa_mask_round_rect(alpha, w, h, lv_obj_get_style_radius(obj, 0));
+
+  lv_opa_t opa = lv_obj_get_style_bg_opa(obj, 0);
+  if (opa < LV_OPA_COVER) {
+    for (int32_t i = 0; i < w * h; i++) {
+      alpha[i] = (alpha[i] * opa) / 255;
+    }
+  }
+}
+
+lv_obj_t *overlay_layer_create(lv_obj_t *obj) {
+  lv_obj_update_layout(obj);
+  int32_t w = lv_obj_get_width(obj);
+  int32_t h = lv_obj_get_height(obj);
+  if (w <= 0 || h <= 0 || w > UINT16_MAX || h > UINT16_MAX) {
+    return NULL;
+  }
+
+  overlay_t *overlay = calloc(1, sizeof(overlay_t));
+  size_t size = (size_t)w * h * 3;
+  uint8_t *data = malloc(size);
+  if (overlay == NULL || data == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate %ldx%ld overlay", (long)w, (long)h);
+    free(overlay);
+    free(data);
+    return NULL;
+  }
+
+  render_color(obj, data, w, h);
+  render_alpha(obj, data + (size_t)w * h * 2, w, h);
+  overlay->source = obj;
+  overlay->data = data;
+  lv_draw_buf_init(&overlay->buf, w, h, LV_COLOR_FORMAT_RGB565A8,
+                   w * sizeof(uint16_t), data, size);
+
+  lv_obj_t *proxy = lv_obj_create(lv_obj_get_parent(obj));
+  lv_obj_remove_style_all(proxy);
+  lv_obj_set_size(proxy, w, h);
+  lv_obj_set_pos(proxy, lv_obj_get_x(obj), lv_obj_get_y(obj));
+  lv_obj_clear_flag(proxy, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_user_data(proxy, overlay);
+  lv_obj_add_event_cb(proxy, overlay_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(proxy, overlay_event_cb, LV_EVENT_DELETE, NULL);
+
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_set_parent(obj, proxy);
+  lv_obj_align(obj, LV_ALIGN_TOP_LEFT, 0, 0); // Same coords as the image
+
+  ESP_LOGD(TAG, "Rendered %ldx%ld overlay (%u bytes)", (long)w, (long)h,
+           (unsigned)size);
+  return proxy;
+}
+
+void overlay_layer_refresh(lv_obj_t *proxy) {
+  overlay_t *overlay = lv_obj_get_user_data(proxy);
+  if (overlay == NULL) {
+    return;
+  }
+
+  lv_obj_t *obj = overlay->source;
+  int32_t w = overlay->buf.header.w;
+  int32_t h = overlay->buf.header.h;
+  lv_obj_update_layout(obj);
+  if (lv_obj_get_width(obj) != w || lv_obj_get_height(obj) != h) {
+    ESP_LOGE(TAG, "Overlay source was resized");
+    return;
+  }
+
+  // Hidden objects are not drawn
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  render_color(obj, overlay->data, w, h);
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+
+  lv_image_cache_drop(&overlay->buf); // Pixels change in place
+  lv_obj_invalidate(proxy);
+}
@@ -0,0 +1,28 @@
+#ifndef OVERLAY_LAYER_H
+#define OVERLAY_LAYER_H
+
+#include "lvgl.h"
+
+/**
+ * @brief Replace an object by a retained image of it, for animation
+ *
+ * obj and its children are rendered once into an RGB565A8 image: alpha
+ * comes from obj's radius and background opacity. A new object showing
+ * the image takes obj's place (same parent, position and size), and obj
+ * is hidden and moved under it, so deleting the overlay deletes both.
+ * Moving the overlay then only blends the image instead of re-rendering
+ * the content every frame. obj must have a solid background; after
+ * changing it (e.g. label text), call overlay_layer_refresh().
+ *
+ * @return The overlay, or NULL if out of memory (obj is left as it was)
+ */
+lv_obj_t *overlay_layer_create(lv_obj_t *obj);
+
+/**
+ * @brief Re-render the image after changing the original object
+ *
+ * Reuses the image buffer; the object's size must not have changed.
+ */
+void overlay_layer_refresh(lv_obj_t *overlay);
+
+#endif // OVERLAY_LAYER_H
@@ -0,0 +1,88 @@
+#include "ui/theme.h"
+
+#define THEME_HEX(c) LV_COLOR_MAKE(((c) >> 16) & 0xFF, ((c) >> 8) & 0xFF, (c) & 0xFF)
+
+#define THEME_PAD(p)                                                           \
+  LV_STYLE_CONST_PAD_TOP(p), LV_STYLE_CONST_PAD_BOTTOM(p),                     \
+      LV_STYLE_CONST_PAD_LEFT(p), LV_STYLE_CONST_PAD_RIGHT(p)
+
+#define THEME_TEXT_STYLE(name, font, color)                                    \
+  static const lv_style_const_prop_t name##_props[] = {                        \
+      LV_STYLE_CONST_TEXT_FONT(font),                                          \
+      LV_STYLE_CONST_TEXT_COLOR(THEME_HEX(color)),                             \
+      LV_STYLE_CONST_PROPS_END,                                                \
+  };                                                                           \
+  LV_STYLE_CONST_INIT(name, name##_props)
+
+// Screens
+static const lv_style_const_prop_t screen_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_BG)),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_screen, screen_props);
+
+static const lv_style_const_prop_t screen_dark_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_BLACK)),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_screen_dark, screen_dark_props);
+
+static const lv_style_const_prop_t screen_ambient_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_AMBIENT_COLOR_BG)),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_screen_ambient, screen_ambient_props);
+
+// Panels
+static const lv_style_const_prop_t container_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_BG)),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    THEME_PAD(0),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_container, container_props);
+
+static const lv_style_const_prop_t card_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_WHITE)),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_RADIUS(10),
+    THEME_PAD(10),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_card, card_props);
+
+static const lv_style_const_prop_t button_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_ORANGE)),
+    LV_STYLE_CONST_RADIUS(10),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_button, button_props);
+
+static const lv_style_const_prop_t toast_props[] = {
+    LV_STYLE_CONST_BG_COLOR(THEME_HEX(THEME_COLOR_BLACK)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_90),
+    LV_STYLE_CONST_BORDER_WIDTH(2),
+    LV_STYLE_CONST_BORDER_COLOR(THEME_HEX(THEME_COLOR_ORANGE)),
+    LV_STYLE_CONST_RADIUS(10),
+    THEME_PAD(10),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_toast, toast_props);
+
+// Text
+THEME_TEXT_STYLE(theme_style_title, THEME_FONT_MEDIUM, THEME_COLOR_BLACK);
+THEME_TEXT_STYLE(theme_style_label, THEME_FONT_NORMAL, THEME_COLOR_BLACK);
+THEME_TEXT_STYLE(theme_style_label_muted, THEME_FONT_NORMAL, THEME_COLOR_GRAY);
+THEME_TEXT_STYLE(theme_style_label_light, THEME_FONT_NORMAL, THEME_COLOR_WHITE);
+THEME_TEXT_STYLE(theme_style_caption, THEME_FONT_SMALL, THEME_COLOR_GRAY);
+THEME_TEXT_STYLE(theme_style_caption_accent, THEME_FONT_SMALL,
+                 THEME_COLOR_ORANGE);
+THEME_TEXT_STYLE(theme_style_detail, THEME_FONT_TINY, THEME_COLOR_BLACK);
+
+static const lv_style_const_prop_t caption_light_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(THEME_FONT_SMALL),
+    LV_STYLE_CONST_TEXT_COLOR(THEME_HEX(THEME_COLOR_WHITE)),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END,
+};
+LV_STYLE_CONST_INIT(theme_style_caption_light, caption_light_props);
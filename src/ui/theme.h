@@ -1,6 +1,7 @@
 #ifndef THEME_H
 #define THEME_H
 
+#include "lvgl.h"
 #include <stdint.h>
 
 // Color palette
@@ -10,10 +11,42 @@
 #define THEME_COLOR_ORANGE 0xFF6347
 #define THEME_COLOR_GRAY 0x808080
 
-// Typography
-#define THEME_FONT_LARGE &lv_font_montserrat_42
-#define THEME_FONT_MEDIUM &lv_font_montserrat_28
+// Ambient palette - must survive the panel's 8-colour idle mode, so each
+// channel is either fully on or off
+#define THEME_AMBIENT_COLOR_BG 0x000000
+#define THEME_AMBIENT_COLOR_FG 0xFFFFFF
+#define THEME_AMBIENT_COLOR_ACCENT 0xFF0000
+
+// Typography. LARGE and MEDIUM are subsets generated at build time from
+// tools/fonts.json: LARGE holds only the clock digits, MEDIUM only the
+// characters used in UI string literals.
+LV_FONT_DECLARE(lv_font_clock_42)
+LV_FONT_DECLARE(lv_font_title_28)
+
+#define THEME_FONT_LARGE &lv_font_clock_42
+#define THEME_FONT_MEDIUM &lv_font_title_28
 #define THEME_FONT_NORMAL &lv_font_montserrat_16
 #define THEME_FONT_SMALL &lv_font_montserrat_14
+#define THEME_FONT_TINY &lv_font_montserrat_12
+
+// Shared styles, one per role (const, in flash). Add them with
+// lv_obj_add_style(obj, &theme_style_x, 0) instead of setting local style
+// properties, which allocate per object. Layout (size, pads between flex
+// items) stays local.
+extern const lv_style_t theme_style_screen;         // Default background
+extern const lv_style_t theme_style_screen_dark;    // Black background
+extern const lv_style_t theme_style_screen_ambient; // Ambient background
+extern const lv_style_t theme_style_container;      // Borderless, no padding
+extern const lv_style_t theme_style_card;           // White rounded panel
+extern const lv_style_t theme_style_button;         // Orange rounded button
+extern const lv_style_t theme_style_toast;          // Dark overlay panel
+extern const lv_style_t theme_style_title;          // Screen title
+extern const lv_style_t theme_style_label;          // Body text
+extern const lv_style_t theme_style_label_muted;    // Secondary body text
+extern const lv_style_t theme_style_label_light;    // Body text on dark
+extern const lv_style_t theme_style_caption;        // Small grey text
+extern const lv_style_t theme_style_caption_accent; // Small orange text
+extern const lv_style_t theme_style_caption_light;  // Small centred white
+extern const lv_style_t theme_style_detail;         // Tiny body text
 
 #endif // THEME_H
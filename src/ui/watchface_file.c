@@ -0,0 +1,461 @@
+#include "ui/watchface_file.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ui/theme.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "watchface_file";
+
+// File layout (little endian), see tools/wfc.py
+#define FILE_MAGIC "WFC1"
+#define FILE_VERSION 1
+#define SOURCE_CLOCK 0
+#define SOURCE_BATTERY 1
+#define SOURCE_STEPS 2
+#define FONT_COUNT 6
+
+// Faces are drawn full screen, so everything must fit the panel
+#define PANEL_W ST7789_H_RES
+#define PANEL_H ST7789_V_RES
+
+typedef struct {
+  char magic[4];
+  uint16_t version;
+  uint16_t prim_count;
+  uint8_t layer_count;
+  uint8_t source_count;
+  uint16_t ambient_y_start; // Ambient rows unset when end <= start
+  uint16_t ambient_y_end;
+  uint16_t strings_size;
+  uint16_t reserved[2];
+  uint32_t palette[WATCHFACE_PALETTE_SIZE];
+  uint32_t ambient_palette[WATCHFACE_PALETTE_SIZE];
+} file_header_t;
+
+typedef struct {
+  int16_t x1, y1, x2, y2;
+} file_layer_t;
+
+typedef struct {
+  uint8_t type, bind, slot, index, radius, color, color_on, flags;
+  int16_t x, y, w, h, step;
+  uint8_t font; // FONT_COUNT ids, 0 = none
+  uint8_t reserved;
+  uint16_t text; // String offset + 1, 0 = none
+  uint16_t reserved2;
+} file_prim_t;
+
+typedef struct {
+  uint8_t kind;
+  uint8_t slot;
+  uint8_t arg;      // BATTERY/STEPS: value at 100%
+  uint8_t reserved;
+  uint16_t format;  // CLOCK: strftime format, string offset + 1
+  uint16_t reserved2;
+} file_source_t;
+
+_Static_assert(sizeof(file_header_t) == 84, "face header size");
+_Static_assert(sizeof(file_layer_t) == 8, "face layer size");
+_Static_assert(sizeof(file_prim_t) == 24, "face primitive size");
+_Static_assert(sizeof(file_source_t) == 8, "face source size");
+
+struct watchface_file {
+  watchface_face_t face;
+  const file_header_t *header;
+  const file_source_t *sources; // In the file data
+  const char *strings;
+  int32_t *keys;                // Last formatted clock key per source
+  bool applied;
+};
+
+static const lv_font_t *font_for_id(uint8_t id) {
+  switch (id) {
+  case 1:
+    return THEME_FONT_LARGE;
+  case 2:
+    return THEME_FONT_MEDIUM;
+  case 3:
+    return THEME_FONT_NORMAL;
+  case 4:
+    return THEME_FONT_SMALL;
+  case 5:
+    return THEME_FONT_TINY;
+  default:
+    return NULL;
+  }
+}
+
+static size_t align4(size_t size) { return (size + 3) & ~(size_t)3; }
+
+// What strftime can output in the C locale, per conversion
+#define DIGITS "0123456789"
+#define DAY_NAMES "SundayMondayTuesdayWednesdayThursdayFridaySaturday"
+#define MONTH_NAMES                                                            \
+  "JanuaryFebruaryMarchAprilMayJuneJulyAugustSeptemberOctoberNovember"       \
+  "December"
+
+typedef struct {
+  const char *conversions;
+  const char *chars;
+  uint8_t max_len;
+} conversion_t;
+
+static const conversion_t conversions[] = {
+    {"CdgHImMSUVWy", DIGITS, 2},
+    {"uw", DIGITS, 1},
+    {"j", DIGITS, 3},
+    {"GY", DIGITS, 4},
+    {"ekl", " " DIGITS, 2},
+    {"R", ":" DIGITS, 5},
+    {"TX", ":" DIGITS, 8},
+    {"Dx", "/" DIGITS, 8},
+    {"F", "-" DIGITS, 10},
+    {"r", ": AMP" DIGITS, 11},
+    {"p", "AMP", 2},
+    {"a", DAY_NAMES, 3},
+    {"A", DAY_NAMES, 9},
+    {"bh", MONTH_NAMES, 3},
+    {"B", MONTH_NAMES, 9},
+    {"c", " :" DIGITS DAY_NAMES MONTH_NAMES, 24},
+    {"%", "%", 1},
+};
+
+/**
+ * @brief Look up a strftime conversion, NULL if unsupported
+ */
+static const conversion_t *find_conversion(char conversion) {
+  if (conversion == '\0') {
+    return NULL;
+  }
+  for (size_t i = 0; i < sizeof(conversions) / sizeof(conversions[0]); i++) {
+    if (strchr(conversions[i].conversions, conversion) != NULL) {
+      return &conversions[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Check a strftime format always fits a text slot
+ */
+static bool format_fits(const char *format) {
+  size_t len = 0;
+  for (size_t i = 0; format[i] != '\0'; i++) {
+    if (format[i] != '%') {
+      len++;
+      continue;
+    }
+    const conversion_t *conversion = find_conversion(format[++i]);
+    if (conversion == NULL) {
+      return false;
+    }
+    len += conversion->max_len;
+  }
+  return len < WATCHFACE_TEXT_MAX;
+}
+
+static bool font_has(const lv_font_t *font, uint32_t letter) {
+  lv_font_glyph_dsc_t glyph;
+  return lv_font_get_glyph_dsc(font, &glyph, letter, 0);
+}
+
+/**
+ * @brief Check the font has a glyph for every character of text
+ */
+static bool font_covers(const lv_font_t *font, const char *text) {
+  uint32_t i = 0;
+  while (text[i] != '\0') {
+    if (!font_has(font, lv_text_encoded_next(text, &i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Check the font has a glyph for everything a strftime format outputs
+ *
+ * Conversions not in conversions[] are refused.
+ */
+static bool font_covers_format(const lv_font_t *font, const char *format) {
+  uint32_t i = 0;
+  while (format[i] != '\0') {
+    if (format[i] != '%') {
+      if (!font_has(font, lv_text_encoded_next(format, &i))) {
+        return false;
+      }
+      continue;
+    }
+
+    const conversion_t *conversion = find_conversion(format[i + 1]);
+    if (conversion == NULL || !font_covers(font, conversion->chars)) {
+      return false;
+    }
+    i += 2;
+  }
+  return true;
+}
+
+/**
+ * @brief Check every record refers to things that exist
+ */
+static bool file_is_valid(const file_header_t *header,
+                          const file_layer_t *layers,
+                          const file_prim_t *prims,
+                          const file_source_t *sources, const char *strings) {
+  if (header->layer_count > WATCHFACE_MAX_LAYERS ||
+      (header->strings_size > 0 &&
+       strings[header->strings_size - 1] != '\0')) {
+    return false;
+  }
+
+  if (header->ambient_y_end > header->ambient_y_start &&
+      header->ambient_y_end >= PANEL_H) {
+    ESP_LOGE(TAG, "Ambient rows %u..%u are off the panel",
+             header->ambient_y_start, header->ambient_y_end);
+    return false;
+  }
+
+  for (uint8_t i = 0; i < header->layer_count; i++) {
+    const file_layer_t *layer = &layers[i];
+    if (layer->x1 < 0 || layer->y1 < 0 || layer->x2 < layer->x1 ||
+        layer->y2 < layer->y1 || layer->x2 >= PANEL_W ||
+        layer->y2 >= PANEL_H) {
+      ESP_LOGE(TAG, "Static layer %u is off the panel", i);
+      return false;
+    }
+  }
+
+  for (uint16_t i = 0; i < header->prim_count; i++) {
+    const file_prim_t *prim = &prims[i];
+    uint8_t slots = (prim->bind == WATCHFACE_BIND_TEXT) ? WATCHFACE_TEXT_SLOTS
+                                                        : WATCHFACE_VALUE_SLOTS;
+    if (prim->type > WATCHFACE_PRIM_IMAGE ||
+        prim->bind > WATCHFACE_BIND_TEXT || prim->slot >= slots ||
+        prim->color >= WATCHFACE_PALETTE_SIZE ||
+        prim->color_on >= WATCHFACE_PALETTE_SIZE ||
+        prim->font >= FONT_COUNT || prim->text > header->strings_size ||
+        ((prim->type == WATCHFACE_PRIM_TEXT ||
+          prim->type == WATCHFACE_PRIM_DIGITS) &&
+         prim->font == 0) ||
+        (prim->type == WATCHFACE_PRIM_IMAGE && prim->text == 0)) {
+      ESP_LOGE(TAG, "Primitive %u is invalid", i);
+      return false;
+    }
+  }
+
+  for (uint8_t i = 0; i < header->source_count; i++) {
+    const file_source_t *source = &sources[i];
+    bool clock = source->kind == SOURCE_CLOCK;
+    if (source->kind > SOURCE_STEPS ||
+        source->slot >= (clock ? WATCHFACE_TEXT_SLOTS : WATCHFACE_VALUE_SLOTS) ||
+        (clock && (source->format == 0 ||
+                   source->format > header->strings_size ||
+                   !format_fits(strings + source->format - 1)))) {
+      ESP_LOGE(TAG, "Source %u is invalid", i);
+      return false;
+    }
+  }
+
+  // The large and medium fonts are subsets (tools/fonts.json), so text
+  // and the clock formats feeding it must stay within their glyphs
+  for (uint16_t i = 0; i < header->prim_count; i++) {
+    const file_prim_t *prim = &prims[i];
+    if (prim->type != WATCHFACE_PRIM_TEXT &&
+        prim->type != WATCHFACE_PRIM_DIGITS) {
+      continue;
+    }
+    const lv_font_t *font = font_for_id(prim->font);
+    bool covered =
+        prim->text == 0 || font_covers(font, strings + prim->text - 1);
+    for (uint8_t s = 0; covered && prim->bind == WATCHFACE_BIND_TEXT &&
+                        s < header->source_count;
+         s++) {
+      if (sources[s].kind == SOURCE_CLOCK && sources[s].slot == prim->slot) {
+        covered = font_covers_format(font, strings + sources[s].format - 1);
+      }
+    }
+    if (!covered) {
+      ESP_LOGE(TAG, "Primitive %u needs glyphs its font lacks", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+esp_err_t watchface_file_load(const char *path, watchface_file_t **out) {
+  int64_t start_us = esp_timer_get_time();
+
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    ESP_LOGE(TAG, "Failed to open %s", path);
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  file_header_t header;
+  if (fread(&header, sizeof(header), 1, f) != 1) {
+    ESP_LOGE(TAG, "%s is not a face file", path);
+    fclose(f);
+    return ESP_ERR_INVALID_RESPONSE;
+  }
+
+  long size = -1;
+  if (fseek(f, 0, SEEK_END) == 0) {
+    size = ftell(f);
+  }
+  size_t records = sizeof(file_header_t) +
+                   header.layer_count * sizeof(file_layer_t) +
+                   header.prim_count * sizeof(file_prim_t) +
+                   header.source_count * sizeof(file_source_t);
+  if (size < 0 || memcmp(header.magic, FILE_MAGIC, 4) != 0 ||
+      header.version != FILE_VERSION ||
+      (size_t)size != records + header.strings_size) {
+    ESP_LOGE(TAG, "%s is not a face file", path);
+    fclose(f);
+    return ESP_ERR_INVALID_RESPONSE;
+  }
+
+  // One block: state, primitive table, layer areas, clock keys, file data
+  size_t prims_at = align4(sizeof(watchface_file_t));
+  size_t layers_at =
+      prims_at + align4(header.prim_count * sizeof(watchface_prim_t));
+  size_t keys_at = layers_at + align4(header.layer_count * sizeof(lv_area_t));
+  size_t data_at = keys_at + align4(header.source_count * sizeof(int32_t));
+  uint8_t *block = calloc(1, data_at + size);
+  if (block == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate %u bytes for %s",
+             (unsigned)(data_at + size), path);
+    fclose(f);
+    return ESP_ERR_NO_MEM;
+  }
+
+  uint8_t *data = block + data_at;
+  bool read = fseek(f, 0, SEEK_SET) == 0 && fread(data, size, 1, f) == 1;
+  fclose(f);
+
+  const file_header_t *file_header = (const file_header_t *)data;
+  const file_layer_t *file_layers =
+      (const file_layer_t *)(data + sizeof(file_header_t));
+  const file_prim_t *file_prims =
+      (const file_prim_t *)(file_layers + header.layer_count);
+  const file_source_t *file_sources =
+      (const file_source_t *)(file_prims + header.prim_count);
+  const char *strings = (const char *)(file_sources + header.source_count);
+  if (!read ||
+      !file_is_valid(file_header, file_layers, file_prims, file_sources,
+                     strings)) {
+    ESP_LOGE(TAG, "%s is corrupt", path);
+    free(block);
+    return ESP_ERR_INVALID_RESPONSE;
+  }
+
+  watchface_file_t *file = (watchface_file_t *)block;
+  watchface_prim_t *prims = (watchface_prim_t *)(block + prims_at);
+  lv_area_t *layers = (lv_area_t *)(block + layers_at);
+  for (uint16_t i = 0; i < header.prim_count; i++) {
+    const file_prim_t *in = &file_prims[i];
+    prims[i] = (watchface_prim_t){
+        .type = in->type,
+        .bind = in->bind,
+        .slot = in->slot,
+        .index = in->index,
+        .radius = in->radius,
+        .color = in->color,
+        .color_on = in->color_on,
+        .flags = in->flags,
+        .x = in->x,
+        .y = in->y,
+        .w = in->w,
+        .h = in->h,
+        .step = in->step,
+        .font = font_for_id(in->font),
+        .text = in->text ? strings + in->text - 1 : NULL,
+    };
+  }
+  for (uint8_t i = 0; i < header.layer_count; i++) {
+    lv_area_set(&layers[i], file_layers[i].x1, file_layers[i].y1,
+                file_layers[i].x2, file_layers[i].y2);
+  }
+
+  file->face.prims = prims;
+  file->face.prim_count = header.prim_count;
+  file->face.static_layers = layers;
+  file->face.static_layer_count = header.layer_count;
+  memcpy(file->face.palette, header.palette, sizeof(header.palette));
+  memcpy(file->face.ambient_palette, header.ambient_palette,
+         sizeof(header.ambient_palette));
+  file->header = file_header;
+  file->sources = file_sources;
+  file->strings = strings;
+  file->keys = (int32_t *)(block + keys_at);
+
+  ESP_LOGI(TAG, "Loaded %s: %u primitives, %ld bytes in %lu us", path,
+           header.prim_count, size,
+           (unsigned long)(esp_timer_get_time() - start_us));
+  *out = file;
+  return ESP_OK;
+}
+
+void watchface_file_free(watchface_file_t *file) { free(file); }
+
+const watchface_face_t *watchface_file_get_face(const watchface_file_t *file) {
+  return &file->face;
+}
+
+bool watchface_file_get_ambient_rows(const watchface_file_t *file,
+                                     uint16_t *y_start, uint16_t *y_end) {
+  if (file->header->ambient_y_end <= file->header->ambient_y_start) {
+    return false;
+  }
+  *y_start = file->header->ambient_y_start;
+  *y_end = file->header->ambient_y_end;
+  return true;
+}
+
+/**
+ * @brief Clock key: changes when the formatted text can
+ */
+static int32_t clock_key(const char *format, const struct tm *time) {
+  int32_t minute = time->tm_yday * 1440 + time->tm_hour * 60 + time->tm_min;
+  if (strstr(format, "%S") != NULL || strstr(format, "%T") != NULL ||
+      strstr(format, "%X") != NULL || strstr(format, "%r") != NULL ||
+      strstr(format, "%c") != NULL) {
+    return minute * 60 + time->tm_sec;
+  }
+  return minute;
+}
+
+void watchface_file_update(watchface_file_t *file, lv_obj_t *obj,
+                           const watchface_model_t *model) {
+  for (uint8_t i = 0; i < file->header->source_count; i++) {
+    const file_source_t *source = &file->sources[i];
+
+    if (source->kind == SOURCE_CLOCK) {
+      const char *format = file->strings + source->format - 1;
+      int32_t key = clock_key(format, &model->time);
+      if (file->applied && key == file->keys[i]) {
+        continue;
+      }
+      char text[WATCHFACE_TEXT_MAX];
+      if (strftime(text, sizeof(text), format, &model->time) == 0) {
+        text[0] = '\0'; // Can't overflow (format_fits), but never pass junk
+      }
+      watchface_engine_set_text(obj, source->slot, text);
+      file->keys[i] = key;
+      continue;
+    }
+
+    // The engine ignores values that didn't change
+    int32_t value;
+    if (source->kind == SOURCE_BATTERY) {
+      value = model->battery * source->arg / 100;
+    } else {
+      uint32_t goal = model->steps_goal ? model->steps_goal : 1;
+      value = LV_MIN(model->steps * source->arg / goal, source->arg);
+    }
+    watchface_engine_set_value(obj, source->slot, value);
+  }
+  file->applied = true;
+}
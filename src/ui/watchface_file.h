@@ -0,0 +1,58 @@
+#ifndef WATCHFACE_FILE_H
+#define WATCHFACE_FILE_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+#include "ui/widgets/watchface_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Data a face file's sources can bind to
+ */
+typedef struct {
+  struct tm time;
+  uint8_t battery; // %
+  uint32_t steps;
+  uint32_t steps_goal;
+} watchface_model_t;
+
+typedef struct watchface_file watchface_file_t;
+
+/**
+ * @brief Load a face compiled with tools/wfc.py
+ *
+ * The file is read into a single allocation that also holds the
+ * primitive table for watchface_engine_create(), so a face costs one
+ * heap block whatever its primitive count, and adding faces costs no
+ * firmware. Load time is logged.
+ */
+esp_err_t watchface_file_load(const char *path, watchface_file_t **out);
+
+/**
+ * @brief Free a face (delete its engine object first)
+ */
+void watchface_file_free(watchface_file_t *file);
+
+/**
+ * @brief Face description to pass to watchface_engine_create()
+ */
+const watchface_face_t *watchface_file_get_face(const watchface_file_t *file);
+
+/**
+ * @brief Rows to keep lit in ambient mode, if the face sets them
+ */
+bool watchface_file_get_ambient_rows(const watchface_file_t *file,
+                                     uint16_t *y_start, uint16_t *y_end);
+
+/**
+ * @brief Feed the model through the face's sources into its slots
+ *
+ * Clock text is only formatted when its minute (or second, for formats
+ * showing seconds) changes. Must hold the LVGL lock.
+ */
+void watchface_file_update(watchface_file_t *file, lv_obj_t *obj,
+                           const watchface_model_t *model);
+
+#endif // WATCHFACE_FILE_H
@@ -0,0 +1,332 @@
+#include "ui/widgets/analog_face.h"
+#include "display_hal.h"
+#include "esp_log.h"
+#include "fixed_trig.h"
+#include "ui/theme.h"
+#include <stdlib.h>
+
+static const char *TAG = "analog_face";
+
+#ifndef ANALOG_FACE_SWEEP_MS
+#define ANALOG_FACE_SWEEP_MS 100 // About one pixel at the second hand's tip
+#endif
+
+#define HAND_PARTS 4       // Boxes invalidated per hand move
+#define DIAL_MARGIN 8      // Between the dial and the object's edge
+#define TICK_INSET 6       // Tick centres inside the dial radius
+#define CAP_SIZE 10        // Centre cap
+#define STATS_WINDOW_MS 1000
+#define STATS_LOG_WINDOWS 10
+
+enum { HAND_HOUR, HAND_MINUTE, HAND_SECOND, HAND_COUNT };
+
+typedef struct {
+  uint8_t length; // % of the dial radius
+  uint8_t tail;   // % of the dial radius behind the centre
+  uint8_t width;
+  bool accent;    // Second hand colour
+} hand_style_t;
+
+static const hand_style_t hand_styles[HAND_COUNT] = {
+    [HAND_HOUR] = {.length = 50, .width = 8},
+    [HAND_MINUTE] = {.length = 80, .width = 6},
+    [HAND_SECOND] = {.length = 90, .tail = 18, .width = 2, .accent = true},
+};
+
+typedef struct {
+  int32_t angles[HAND_COUNT]; // As drawn (FIXED_TRIG_TURN units)
+  bool second_shown;
+  uint8_t hour, minute, second;
+  uint32_t second_tick; // lv_tick when the current second started
+  bool sweep;
+  bool ambient;
+  lv_timer_t *timer;
+
+  // Sweep cost over the current window
+  uint32_t window_start;
+  uint32_t frames;
+  uint32_t bytes_mark;
+  uint32_t windows;
+  analog_face_stats_t stats;
+} analog_face_t;
+
+// Pixel bytes sent to the panel; the tap can't be removed, so it is
+// shared and each face reads differences
+static volatile uint32_t flushed_bytes = 0;
+static bool tap_added = false;
+
+static void flush_tap(const lv_area_t *area, const uint16_t *pixels) {
+  flushed_bytes += lv_area_get_size(area) * sizeof(uint16_t);
+}
+
+/**
+ * @brief Dial centre (screen coordinates) and radius
+ */
+static int32_t dial_geometry(lv_obj_t *obj, int32_t *cx, int32_t *cy) {
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  *cx = coords.x1 + lv_area_get_width(&coords) / 2;
+  *cy = coords.y1 + lv_area_get_height(&coords) / 2;
+  return LV_MIN(lv_area_get_width(&coords), lv_area_get_height(&coords)) / 2 -
+         DIAL_MARGIN;
+}
+
+/**
+ * @brief Invalidate what a hand covers while turning from from to to
+ *
+ * The hand is cut into HAND_PARTS lengths with a box each, so a diagonal
+ * hand doesn't invalidate the whole square around it.
+ */
+static void hand_invalidate(lv_obj_t *obj, int hand, int32_t from,
+                            int32_t to) {
+  const hand_style_t *style = &hand_styles[hand];
+  int32_t cx;
+  int32_t cy;
+  int32_t radius = dial_geometry(obj, &cx, &cy);
+  int32_t tail = radius * style->tail / 100;
+  int32_t length = radius * style->length / 100;
+  int32_t pad = style->width / 2 + 1; // Round ends and anti-aliasing
+
+  for (int part = 0; part < HAND_PARTS; part++) {
+    int32_t r0 = -tail + (length + tail) * part / HAND_PARTS;
+    int32_t r1 = -tail + (length + tail) * (part + 1) / HAND_PARTS;
+    fixed_trig_box_t box;
+    fixed_trig_sweep_box(cx, cy, from, to, r0, r1, pad, &box);
+    lv_area_t area = {box.x1, box.y1, box.x2, box.y2};
+    lv_obj_invalidate_area(obj, &area);
+  }
+}
+
+/**
+ * @brief Move the hands to the current time, invalidating only their sweep
+ */
+static void update_hands(lv_obj_t *obj, analog_face_t *face) {
+  bool second_shown = face->sweep && !face->ambient;
+  uint32_t ms = second_shown ? LV_MIN(lv_tick_elaps(face->second_tick), 999)
+                             : 0;
+  int32_t seconds = face->second;
+  int32_t minutes = face->minute * 60 + seconds;
+  int32_t hours = (face->hour % 12) * 3600 + minutes;
+
+  int32_t angles[HAND_COUNT];
+  angles[HAND_SECOND] =
+      (seconds * 1000 + (int32_t)ms) * FIXED_TRIG_TURN / 60000;
+  angles[HAND_MINUTE] = minutes * FIXED_TRIG_TURN / 3600;
+  angles[HAND_HOUR] = hours * FIXED_TRIG_TURN / 43200;
+
+  for (int hand = 0; hand < HAND_COUNT; hand++) {
+    if (hand == HAND_SECOND && second_shown != face->second_shown) {
+      // Appears or disappears: its old and new place only
+      hand_invalidate(obj, hand, face->angles[hand], face->angles[hand]);
+      hand_invalidate(obj, hand, angles[hand], angles[hand]);
+      face->second_shown = second_shown;
+    } else if (angles[hand] != face->angles[hand] &&
+               (hand != HAND_SECOND || second_shown)) {
+      hand_invalidate(obj, hand, face->angles[hand], angles[hand]);
+    }
+    face->angles[hand] = angles[hand];
+  }
+}
+
+static void stats_window_reset(analog_face_t *face) {
+  face->window_start = lv_tick_get();
+  face->frames = 0;
+  face->bytes_mark = flushed_bytes;
+}
+
+/**
+ * @brief Close the stats window once a second
+ */
+static void stats_update(analog_face_t *face) {
+  uint32_t elapsed = lv_tick_elaps(face->window_start);
+  if (elapsed < STATS_WINDOW_MS) {
+    return;
+  }
+
+  uint32_t bytes = flushed_bytes - face->bytes_mark;
+  face->stats.fps = face->frames * 1000 / elapsed;
+  face->stats.bytes_per_s = (uint32_t)((uint64_t)bytes * 1000 / elapsed);
+  stats_window_reset(face);
+
+  if (++face->windows % STATS_LOG_WINDOWS == 0) {
+    ESP_LOGI(TAG, "Sweep: %lu fps, %lu bytes/s",
+             (unsigned long)face->stats.fps,
+             (unsigned long)face->stats.bytes_per_s);
+  }
+}
+
+static void sweep_timer_cb(lv_timer_t *timer) {
+  lv_obj_t *obj = lv_timer_get_user_data(timer);
+  analog_face_t *face = lv_obj_get_user_data(obj);
+  update_hands(obj, face);
+  stats_update(face);
+}
+
+static void render_ready_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_user_data(e);
+  analog_face_t *face = lv_obj_get_user_data(obj);
+  if (face->sweep) {
+    face->frames++;
+  }
+}
+
+static void draw_dot(lv_layer_t *layer, int32_t x, int32_t y, int32_t size,
+                     lv_color_t color) {
+  lv_area_t area = {x - size / 2, y - size / 2, x - size / 2 + size - 1,
+                    y - size / 2 + size - 1};
+  if (lv_area_is_on(&area, &layer->_clip_area)) {
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+    dsc.radius = LV_RADIUS_CIRCLE;
+    lv_draw_rect(layer, &dsc, &area);
+  }
+}
+
+static void draw_face(lv_obj_t *obj, analog_face_t *face, lv_layer_t *layer) {
+  lv_color_t fg = lv_color_hex(face->ambient ? THEME_AMBIENT_COLOR_FG
+                                             : THEME_COLOR_BLACK);
+  lv_color_t accent = lv_color_hex(THEME_COLOR_ORANGE);
+  int32_t cx;
+  int32_t cy;
+  int32_t radius = dial_geometry(obj, &cx, &cy);
+
+  // Hour ticks, larger at 12, 3, 6 and 9
+  for (int i = 0; i < 12; i++) {
+    int32_t x;
+    int32_t y;
+    fixed_trig_point(cx, cy, i * FIXED_TRIG_TURN / 12, radius - TICK_INSET,
+                     &x, &y);
+    draw_dot(layer, x, y, (i % 3 == 0) ? 8 : 4, fg);
+  }
+
+  lv_draw_line_dsc_t line;
+  lv_draw_line_dsc_init(&line);
+  line.round_start = 1;
+  line.round_end = 1;
+  for (int hand = 0; hand < HAND_COUNT; hand++) {
+    if (hand == HAND_SECOND && !face->second_shown) {
+      continue;
+    }
+    const hand_style_t *style = &hand_styles[hand];
+    int32_t x;
+    int32_t y;
+    fixed_trig_point(cx, cy, face->angles[hand],
+                     -(radius * style->tail / 100), &x, &y);
+    line.p1.x = x;
+    line.p1.y = y;
+    fixed_trig_point(cx, cy, face->angles[hand],
+                     radius * style->length / 100, &x, &y);
+    line.p2.x = x;
+    line.p2.y = y;
+    line.width = style->width;
+    line.color = style->accent ? accent : fg;
+    lv_draw_line(layer, &line);
+  }
+
+  draw_dot(layer, cx, cy, CAP_SIZE, fg);
+  if (face->second_shown) {
+    draw_dot(layer, cx, cy, CAP_SIZE / 2, accent);
+  }
+}
+
+static void analog_face_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  analog_face_t *face = lv_obj_get_user_data(obj);
+
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+    lv_display_remove_event_cb_with_user_data(lv_obj_get_display(obj),
+                                              render_ready_cb, obj);
+    lv_timer_delete(face->timer);
+    free(face);
+    return;
+  }
+
+  // LV_EVENT_DRAW_MAIN
+  draw_face(obj, face, lv_event_get_layer(e));
+}
+
+lv_obj_t *analog_face_create(lv_obj_t *parent) {
+  analog_face_t *face = calloc(1, sizeof(analog_face_t));
+  if (face == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate face state");
+    return NULL;
+  }
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_user_data(obj, face);
+
+  face->timer = lv_timer_create(sweep_timer_cb, ANALOG_FACE_SWEEP_MS, obj);
+  if (face->timer == NULL) {
+    ESP_LOGE(TAG, "Failed to create sweep timer");
+    lv_obj_delete(obj);
+    free(face);
+    return NULL;
+  }
+  lv_timer_pause(face->timer);
+
+  lv_obj_add_event_cb(obj, analog_face_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, analog_face_event_cb, LV_EVENT_DELETE, NULL);
+  lv_display_add_event_cb(lv_obj_get_display(obj), render_ready_cb,
+                          LV_EVENT_RENDER_READY, obj);
+
+  if (!tap_added) {
+    tap_added = display_hal_add_flush_tap(flush_tap) == ESP_OK;
+    if (!tap_added) {
+      ESP_LOGW(TAG, "No flush tap, bytes/s will read 0");
+    }
+  }
+  return obj;
+}
+
+void analog_face_set_time(lv_obj_t *obj, const struct tm *time) {
+  analog_face_t *face = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (face == NULL || time == NULL) {
+    return;
+  }
+
+  face->hour = time->tm_hour;
+  face->minute = time->tm_min;
+  face->second = time->tm_sec;
+  face->second_tick = lv_tick_get();
+  update_hands(obj, face);
+}
+
+void analog_face_set_sweep(lv_obj_t *obj, bool sweep) {
+  analog_face_t *face = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (face == NULL || face->sweep == sweep) {
+    return;
+  }
+
+  face->sweep = sweep;
+  if (sweep) {
+    stats_window_reset(face);
+    lv_timer_resume(face->timer);
+  } else {
+    lv_timer_pause(face->timer);
+  }
+  update_hands(obj, face);
+}
+
+void analog_face_set_ambient(lv_obj_t *obj, bool ambient) {
+  analog_face_t *face = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (face == NULL || face->ambient == ambient) {
+    return;
+  }
+
+  face->ambient = ambient;
+  update_hands(obj, face);
+  lv_obj_invalidate(obj);
+}
+
+void analog_face_get_stats(lv_obj_t *obj, analog_face_stats_t *stats) {
+  analog_face_t *face = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (face == NULL) {
+    *stats = (analog_face_stats_t){0};
+    return;
+  }
+  *stats = face->stats;
+}
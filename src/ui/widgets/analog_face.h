@@ -0,0 +1,50 @@
+#ifndef ANALOG_FACE_H
+#define ANALOG_FACE_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Measured cost of the face while sweeping (last second)
+ */
+typedef struct {
+  uint32_t fps;         // Frames rendered
+  uint32_t bytes_per_s; // Pixel bytes sent to the panel
+} analog_face_stats_t;
+
+/**
+ * @brief Create an analog dial with hour, minute and second hands
+ *
+ * Fills the parent. Each hand move invalidates only the pixels the hand
+ * sweeps over since it was last drawn (a few exact boxes per hand, from
+ * lib/fixed_trig), so the second hand can sweep smoothly for a small
+ * fraction of a full-screen redraw.
+ */
+lv_obj_t *analog_face_create(lv_obj_t *parent);
+
+/**
+ * @brief Set the time; the sweep continues from this second
+ */
+void analog_face_set_time(lv_obj_t *obj, const struct tm *time);
+
+/**
+ * @brief Start or stop the sweeping second hand
+ *
+ * Stopped, the second hand is not drawn and the other hands move only on
+ * analog_face_set_time(). Stop it while the face is not shown.
+ */
+void analog_face_set_sweep(lv_obj_t *obj, bool sweep);
+
+/**
+ * @brief Switch to the ambient palette
+ */
+void analog_face_set_ambient(lv_obj_t *obj, bool ambient);
+
+/**
+ * @brief Get the achieved frame rate and panel bandwidth of the sweep
+ */
+void analog_face_get_stats(lv_obj_t *obj, analog_face_stats_t *stats);
+
+#endif // ANALOG_FACE_H
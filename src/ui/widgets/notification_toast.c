@@ -2,19 +2,106 @@
 #include "core/event_manager.h"
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "lvgl.h"
+#include "ui/overlay_layer.h"
 #include "ui/theme.h"
+#include <stdio.h>
+#include <string.h>
 
 static const char *TAG = "notification_toast";
 
-static lv_obj_t *toast_container = NULL;
+#define TOAST_WIDTH 220
+#define TOAST_HEIGHT 70
+#define TOAST_Y 10
+#define TOAST_SHOW_MS 3000
+#define TOAST_MIN_INTERVAL_MS 1000 // Between two presentations
+
+// Created once on the top layer and reused for every notification
+static lv_obj_t *toast = NULL; // Overlay image, or the card itself
+static lv_obj_t *title_label = NULL;
+static lv_obj_t *message_label = NULL;
 static lv_timer_t *dismiss_timer = NULL;
+static lv_timer_t *present_timer = NULL;
+static bool toast_visible = false;
+
+// Shown through lv_label_set_text_static: no LVGL allocation per toast
+static char title_text[sizeof(((notification_t *)0)->title)];
+static char message_text[sizeof(((notification_t *)0)->message)];
+
+// Burst coalescing
+static notification_t latest;
+static uint32_t unseen = 0; // Arrived since the toast was last dismissed
+static uint32_t last_present_tick = 0;
+static bool presented_once = false;
+
+static void toast_set_y(void *obj, int32_t y) { lv_obj_set_y(obj, y); }
+
+static void toast_hidden_cb(lv_anim_t *anim) {
+  lv_obj_add_flag(toast, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * @brief Slide the toast to y (replaces a slide still running)
+ */
+static void toast_slide(int32_t y, uint32_t time, lv_anim_path_cb_t path,
+                        lv_anim_completed_cb_t completed_cb) {
+  lv_anim_delete(toast, toast_set_y);
+
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_var(&anim, toast);
+  lv_anim_set_values(&anim, lv_obj_get_y(toast), y);
+  lv_anim_set_duration(&anim, time);
+  lv_anim_set_exec_cb(&anim, toast_set_y);
+  lv_anim_set_path_cb(&anim, path);
+  lv_anim_set_completed_cb(&anim, completed_cb);
+  lv_anim_start(&anim);
+}
+
+/**
+ * @brief Show what arrived since the last presentation
+ *
+ * One notification is shown as is; a burst as a count with the latest
+ * sender. An already visible toast is updated in place.
+ */
+static void toast_present(void) {
+  if (unseen <= 1) {
+    snprintf(title_text, sizeof(title_text), "%s", latest.title);
+    snprintf(message_text, sizeof(message_text), "%s", latest.message);
+  } else {
+    snprintf(title_text, sizeof(title_text), "%lu new notifications",
+             (unsigned long)unseen);
+    snprintf(message_text, sizeof(message_text), "Latest: %s", latest.title);
+  }
+  lv_label_set_text_static(title_label, title_text);
+  lv_label_set_text_static(message_label, message_text);
+  if (toast != lv_obj_get_parent(title_label)) {
+    overlay_layer_refresh(toast);
+  }
+
+  if (!toast_visible) {
+    toast_visible = true;
+    lv_obj_clear_flag(toast, LV_OBJ_FLAG_HIDDEN);
+    toast_slide(TOAST_Y, 300, lv_anim_path_ease_out, NULL);
+  }
+
+  lv_timer_reset(dismiss_timer);
+  lv_timer_resume(dismiss_timer);
+  last_present_tick = lv_tick_get();
+  presented_once = true;
+}
+
+static void toast_present_timer_cb(lv_timer_t *timer) {
+  lv_timer_pause(timer);
+  toast_present();
+}
 
 /**
  * @brief Timer callback to auto-dismiss toast
  */
 static void toast_auto_dismiss_cb(lv_timer_t *timer) {
-  dismiss_timer = NULL;
   notification_toast_dismiss();
 }
 
@@ -42,15 +129,122 @@ static void toast_event_callback(const event_t *event, void *user_data) {
   }
 }
 
+/**
+ * @brief Build the toast (LVGL lock held)
+ */
+static esp_err_t toast_create(void) {
+  lv_obj_t *card = lv_obj_create(lv_layer_top());
+  lv_obj_set_size(card, TOAST_WIDTH, TOAST_HEIGHT);
+  lv_obj_align(card, LV_ALIGN_TOP_MID, 0, -TOAST_HEIGHT);
+  lv_obj_add_style(card, &theme_style_toast, 0);
+  lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+
+  // Title label
+  title_label = lv_label_create(card);
+  lv_label_set_text_static(title_label, title_text);
+  lv_obj_add_style(title_label, &theme_style_label_light, 0);
+  lv_obj_set_width(title_label, TOAST_WIDTH - 20);
+  lv_label_set_long_mode(title_label, LV_LABEL_LONG_DOT);
+  lv_obj_align(title_label, LV_ALIGN_TOP_LEFT, 0, 0);
+
+  // Message label
+  message_label = lv_label_create(card);
+  lv_label_set_text_static(message_label, message_text);
+  lv_obj_add_style(message_label, &theme_style_caption, 0);
+  lv_obj_set_width(message_label, TOAST_WIDTH - 20);
+  lv_label_set_long_mode(message_label, LV_LABEL_LONG_DOT);
+  lv_obj_align(message_label, LV_ALIGN_TOP_LEFT, 0, 22);
+
+  // Slide a pre-rendered image of the card rather than re-rendering the
+  // card on every frame (the card is animated live if memory is short)
+  toast = overlay_layer_create(card);
+  if (toast == NULL) {
+    toast = card;
+  }
+  lv_obj_add_flag(toast, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE |
+                             LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+  // Add gesture detection (swipe right to dismiss)
+  lv_obj_add_event_cb(toast, toast_gesture_cb, LV_EVENT_GESTURE, NULL);
+
+  dismiss_timer = lv_timer_create(toast_auto_dismiss_cb, TOAST_SHOW_MS, NULL);
+  present_timer =
+      lv_timer_create(toast_present_timer_cb, TOAST_MIN_INTERVAL_MS, NULL);
+  if (dismiss_timer == NULL || present_timer == NULL) {
+    ESP_LOGE(TAG, "Failed to create toast timers");
+    return ESP_ERR_NO_MEM;
+  }
+  lv_timer_pause(dismiss_timer);
+  lv_timer_pause(present_timer);
+  return ESP_OK;
+}
+
+#ifdef NOTIFICATION_BURST_TEST
+#define BURST_TEST_DELAY_MS 5000 // Let the UI settle after boot
+
+static void burst_test_log_mem(const char *when) {
+  lv_mem_monitor_t mon;
+  lvgl_port_lock(-1);
+  lv_mem_monitor(&mon);
+  lvgl_port_unlock();
+  ESP_LOGI(TAG, "LVGL heap %s: %lu used, %lu free, biggest %lu, frag %u%%",
+           when, (unsigned long)(mon.total_size - mon.free_size),
+           (unsigned long)mon.free_size, (unsigned long)mon.free_biggest_size,
+           mon.frag_pct);
+}
+
+/**
+ * @brief Post NOTIFICATION_BURST_TEST notifications back to back
+ *
+ * Logs the LVGL heap before, right after, and once the coalesced toast
+ * has been dismissed, so a leak or fragmentation from bursts shows.
+ */
+static void burst_test_task(void *arg) {
+  vTaskDelay(pdMS_TO_TICKS(BURST_TEST_DELAY_MS));
+  burst_test_log_mem("before burst");
+
+  for (uint32_t i = 0; i < NOTIFICATION_BURST_TEST; i++) {
+    notification_t notification = {
+        .id = 1000 + i,
+        .type = NOTIF_TYPE_SYSTEM,
+    };
+    snprintf(notification.title, sizeof(notification.title), "Burst %lu",
+             (unsigned long)i);
+    snprintf(notification.message, sizeof(notification.message),
+             "Notification %lu of %d", (unsigned long)i + 1,
+             NOTIFICATION_BURST_TEST);
+    snprintf(notification.app_name, sizeof(notification.app_name), "Test");
+    event_manager_emit(EVENT_NOTIFICATION_NEW, &notification,
+                       sizeof(notification));
+  }
+  burst_test_log_mem("after burst");
+
+  vTaskDelay(pdMS_TO_TICKS(TOAST_MIN_INTERVAL_MS + TOAST_SHOW_MS + 500));
+  burst_test_log_mem("after dismiss");
+  vTaskDelete(NULL);
+}
+#endif
+
 esp_err_t notification_toast_init(void) {
+  lvgl_port_lock(-1);
+  esp_err_t ret = toast_create();
+  lvgl_port_unlock();
+  if (ret != ESP_OK) {
+    return ret;
+  }
+
   // Subscribe to notification events
-  esp_err_t ret = event_manager_subscribe(EVENT_NOTIFICATION_NEW,
-                                          toast_event_callback, NULL);
+  ret = event_manager_subscribe(EVENT_NOTIFICATION_NEW, toast_event_callback,
+                                NULL);
   if (ret != ESP_OK) {
     ESP_LOGE(TAG, "Failed to subscribe to events: %s", esp_err_to_name(ret));
     return ret;
   }
 
+#ifdef NOTIFICATION_BURST_TEST
+  xTaskCreate(burst_test_task, "toast_burst", 3072, NULL, 2, NULL);
+#endif
+
   ESP_LOGI(TAG, "Notification toast initialized");
   return ESP_OK;
 }
@@ -60,100 +254,49 @@ void notification_toast_show(const notification_t *notification) {
     ESP_LOGE(TAG, "Notification is NULL");
     return;
   }
-
-  // Dismiss existing toast if any
-  if (toast_container != NULL) {
-    notification_toast_dismiss();
+  if (toast == NULL) {
+    ESP_LOGW(TAG, "Toast not initialized");
+    return;
   }
 
   lvgl_port_lock(-1);
 
-  // Get current active screen
-  lv_obj_t *active_screen = lv_scr_act();
-
-  // Create toast container
-  toast_container = lv_obj_create(active_screen);
-  lv_obj_set_size(toast_container, 220, 70);
-  lv_obj_align(toast_container, LV_ALIGN_TOP_MID, 0, 10);
-  lv_obj_set_style_bg_color(toast_container, lv_color_hex(THEME_COLOR_BLACK),
-                            0);
-  lv_obj_set_style_bg_opa(toast_container, LV_OPA_90, 0);
-  lv_obj_set_style_border_width(toast_container, 2, 0);
-  lv_obj_set_style_border_color(toast_container,
-                                lv_color_hex(THEME_COLOR_ORANGE), 0);
-  lv_obj_set_style_radius(toast_container, 10, 0);
-  lv_obj_set_style_pad_all(toast_container, 10, 0);
-  lv_obj_clear_flag(toast_container, LV_OBJ_FLAG_SCROLLABLE);
-  lv_obj_add_flag(toast_container, LV_OBJ_FLAG_GESTURE_BUBBLE);
-  lv_obj_move_foreground(toast_container);
-
-  // Add gesture detection (swipe right to dismiss)
-  lv_obj_add_event_cb(toast_container, toast_gesture_cb, LV_EVENT_GESTURE,
-                      NULL);
-
-  // Title label
-  lv_obj_t *title = lv_label_create(toast_container);
-  lv_label_set_text(title, notification->title);
-  lv_obj_set_style_text_font(title, THEME_FONT_NORMAL, 0);
-  lv_obj_set_style_text_color(title, lv_color_hex(THEME_COLOR_WHITE), 0);
-  lv_obj_align(title, LV_ALIGN_TOP_LEFT, 0, 0);
+  latest = *notification;
+  unseen++;
 
-  // Message label
-  lv_obj_t *message = lv_label_create(toast_container);
-  lv_label_set_text(message, notification->message);
-  lv_obj_set_style_text_font(message, THEME_FONT_SMALL, 0);
-  lv_obj_set_style_text_color(message, lv_color_hex(THEME_COLOR_GRAY), 0);
-  lv_obj_set_width(message, 200);
-  lv_label_set_long_mode(message, LV_LABEL_LONG_DOT);
-  lv_obj_align(message, LV_ALIGN_TOP_LEFT, 0, 22);
-
-  // Slide in animation (from top)
-  lv_obj_set_y(toast_container, -70);
-  lv_anim_t anim;
-  lv_anim_init(&anim);
-  lv_anim_set_var(&anim, toast_container);
-  lv_anim_set_values(&anim, -70, 10);
-  lv_anim_set_time(&anim, 300);
-  lv_anim_set_exec_cb(&anim, (lv_anim_exec_xcb_t)lv_obj_set_y);
-  lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
-  lv_anim_start(&anim);
-
-  // Auto-dismiss after 3 seconds (must be inside LVGL lock)
-  dismiss_timer = lv_timer_create(toast_auto_dismiss_cb, 3000, NULL);
-  lv_timer_set_repeat_count(dismiss_timer, 1);
+  // Rate limit: a burst is collected and presented once
+  uint32_t elapsed = lv_tick_elaps(last_present_tick);
+  if (!presented_once || elapsed >= TOAST_MIN_INTERVAL_MS) {
+    lv_timer_pause(present_timer);
+    toast_present();
+  } else if (lv_timer_get_paused(present_timer)) {
+    lv_timer_set_period(present_timer, TOAST_MIN_INTERVAL_MS - elapsed);
+    lv_timer_reset(present_timer);
+    lv_timer_resume(present_timer);
+  }
 
   lvgl_port_unlock();
 
-  ESP_LOGI(TAG, "Toast shown");
+  ESP_LOGI(TAG, "Toast shown (%lu unseen)", (unsigned long)unseen);
 }
 
 void notification_toast_dismiss(void) {
-  if (toast_container == NULL) {
+  if (toast == NULL || !toast_visible) {
     return;
   }
 
   lvgl_port_lock(-1);
 
-  // Cancel auto-dismiss timer
-  if (dismiss_timer != NULL) {
-    lv_timer_del(dismiss_timer);
-    dismiss_timer = NULL;
-  }
+  // Cancel auto-dismiss and anything still waiting to be presented
+  lv_timer_pause(dismiss_timer);
+  lv_timer_pause(present_timer);
+  toast_visible = false;
+  unseen = 0;
 
-  // Slide out animation (to top)
-  lv_anim_t anim;
-  lv_anim_init(&anim);
-  lv_anim_set_var(&anim, toast_container);
-  lv_anim_set_values(&anim, lv_obj_get_y(toast_container), -70);
-  lv_anim_set_time(&anim, 200);
-  lv_anim_set_exec_cb(&anim, (lv_anim_exec_xcb_t)lv_obj_set_y);
-  lv_anim_set_path_cb(&anim, lv_anim_path_ease_in);
-  lv_anim_set_deleted_cb(&anim, (lv_anim_deleted_cb_t)lv_obj_del);
-  lv_anim_start(&anim);
+  // Slide out animation (to top), then hidden until the next notification
+  toast_slide(-TOAST_HEIGHT, 200, lv_anim_path_ease_in, toast_hidden_cb);
 
   lvgl_port_unlock();
 
-  toast_container = NULL;
-
   ESP_LOGI(TAG, "Toast dismissed");
 }
@@ -7,14 +7,16 @@
 /**
  * @brief Initialize notification toast widget
  *
- * Subscribes to EVENT_NOTIFICATION_NEW to automatically show toast
+ * Creates the toast once on the top layer (hidden until needed) and
+ * subscribes to EVENT_NOTIFICATION_NEW to automatically show it.
  */
 esp_err_t notification_toast_init(void);
 
 /**
  * @brief Show a notification toast
  *
- * Creates a temporary overlay on top of current screen.
+ * Reuses the preallocated toast. Notifications arriving within a second
+ * of the last one shown are coalesced into "N new notifications".
  * Auto-dismisses after 3 seconds.
  * Can be dismissed by swiping right.
  *
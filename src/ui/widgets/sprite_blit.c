@@ -0,0 +1,121 @@
+#include "ui/widgets/sprite_blit.h"
+#include "display_hal.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+static const char *TAG = "sprite_blit";
+
+typedef struct {
+  const uint16_t *frames;
+  uint16_t frame_count;
+  uint16_t frame;
+  lv_image_dsc_t image; // Points at the current frame for LVGL redraws
+} sprite_t;
+
+static void sprite_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  sprite_t *sprite = lv_obj_get_user_data(obj);
+
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+    lv_image_cache_drop(&sprite->image);
+    free(sprite);
+    return;
+  }
+
+  // LV_EVENT_DRAW_MAIN
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+  dsc.src = &sprite->image;
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_draw_image(lv_event_get_layer(e), &dsc, &coords);
+}
+
+/**
+ * @brief Check for a visible overlay (the toast stays on the top layer hidden)
+ */
+static bool top_layer_in_use(void) {
+  lv_obj_t *top = lv_layer_top();
+  for (uint32_t i = 0; i < lv_obj_get_child_count(top); i++) {
+    if (!lv_obj_has_flag(lv_obj_get_child(top, i), LV_OBJ_FLAG_HIDDEN)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check the sprite's pixels on the panel are exactly its frame
+ */
+static bool sprite_can_blit(lv_obj_t *obj, lv_area_t *area) {
+  if (lv_obj_get_screen(obj) != lv_screen_active() ||
+      lv_obj_has_flag_any(obj, LV_OBJ_FLAG_HIDDEN) || top_layer_in_use()) {
+    return false;
+  }
+
+  lv_obj_get_coords(obj, area);
+  lv_area_t visible = *area;
+  return lv_obj_area_is_visible(obj, &visible) &&
+         lv_area_is_equal(&visible, area);
+}
+
+lv_obj_t *sprite_blit_create(lv_obj_t *parent, const uint16_t *frames,
+                             uint16_t w, uint16_t h, uint16_t frame_count) {
+  if (frames == NULL || frame_count == 0) {
+    ESP_LOGE(TAG, "No frames");
+    return NULL;
+  }
+
+  sprite_t *sprite = calloc(1, sizeof(sprite_t));
+  if (sprite == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate sprite");
+    return NULL;
+  }
+
+  sprite->frames = frames;
+  sprite->frame_count = frame_count;
+  sprite->image.header.magic = LV_IMAGE_HEADER_MAGIC;
+  sprite->image.header.cf = LV_COLOR_FORMAT_RGB565;
+  sprite->image.header.w = w;
+  sprite->image.header.h = h;
+  sprite->image.header.stride = w * sizeof(uint16_t);
+  sprite->image.data_size = (uint32_t)w * h * sizeof(uint16_t);
+  sprite->image.data = (const uint8_t *)frames;
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, w, h);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_user_data(obj, sprite);
+  lv_obj_add_event_cb(obj, sprite_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, sprite_event_cb, LV_EVENT_DELETE, NULL);
+
+  return obj;
+}
+
+void sprite_blit_set_frame(lv_obj_t *obj, uint16_t frame) {
+  sprite_t *sprite = lv_obj_get_user_data(obj);
+  if (sprite == NULL || frame >= sprite->frame_count ||
+      frame == sprite->frame) {
+    return;
+  }
+
+  const uint16_t *pixels =
+      sprite->frames + (size_t)frame * sprite->image.header.w *
+                           sprite->image.header.h;
+  sprite->frame = frame;
+  sprite->image.data = (const uint8_t *)pixels;
+  lv_image_cache_drop(&sprite->image); // Cache is keyed by descriptor
+
+  // LVGL keeps no framebuffer: any later redraw paints the same frame
+  lv_area_t area;
+  if (!sprite_can_blit(obj, &area) || display_hal_blit(&area, pixels) != ESP_OK) {
+    lv_obj_invalidate(obj);
+  }
+}
+
+uint16_t sprite_blit_get_frame(const lv_obj_t *obj) {
+  const sprite_t *sprite = lv_obj_get_user_data((lv_obj_t *)obj);
+  return (sprite != NULL) ? sprite->frame : 0;
+}
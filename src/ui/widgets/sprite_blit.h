@@ -0,0 +1,32 @@
+#ifndef SPRITE_BLIT_H
+#define SPRITE_BLIT_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+/**
+ * @brief Create a sprite: an opaque RGB565 image with several frames
+ *
+ * Frames are stored back to back (w * h pixels each) and must outlive the
+ * sprite. Switching frames writes the pixels straight to the panel via
+ * display_hal_blit() instead of going through LVGL render and flush; LVGL
+ * draws the same frame whenever it repaints the area, so both stay in sync.
+ */
+lv_obj_t *sprite_blit_create(lv_obj_t *parent, const uint16_t *frames,
+                             uint16_t w, uint16_t h, uint16_t frame_count);
+
+/**
+ * @brief Show a frame (must hold the LVGL lock)
+ *
+ * Falls back to a normal invalidation when the sprite is clipped, covered
+ * by the top layer or not on the active screen. Later siblings must not
+ * overlap the sprite.
+ */
+void sprite_blit_set_frame(lv_obj_t *sprite, uint16_t frame);
+
+/**
+ * @brief Get the frame currently shown
+ */
+uint16_t sprite_blit_get_frame(const lv_obj_t *sprite);
+
+#endif // SPRITE_BLIT_H
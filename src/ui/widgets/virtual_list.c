@@ -0,0 +1,215 @@
+#include "ui/widgets/virtual_list.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+static const char *TAG = "virtual_list";
+
+#define UNBOUND UINT32_MAX
+
+typedef struct {
+  virtual_list_create_cb_t create_cb;
+  virtual_list_bind_cb_t bind_cb;
+  void *user_data;
+  int32_t pitch; // Row height + gap
+  int32_t row_height;
+  uint32_t count;
+  lv_obj_t *spacer; // Invisible, on the last item's bottom row: sets the
+                    // scrollable height (hidden objects would not count)
+  uint16_t pool_size;
+  lv_obj_t **rows;
+  uint32_t *bound; // Item index shown by each row
+} virtual_list_t;
+
+/**
+ * @brief Create the row pool once the viewport height is known
+ */
+static bool ensure_pool(lv_obj_t *obj, virtual_list_t *list) {
+  if (list->rows != NULL) {
+    return true;
+  }
+
+  lv_obj_update_layout(obj);
+  int32_t view_h = lv_obj_get_content_height(obj);
+  list->pool_size = (view_h + list->pitch - 1) / list->pitch + 1;
+  list->rows = calloc(list->pool_size, sizeof(lv_obj_t *));
+  list->bound = malloc(list->pool_size * sizeof(uint32_t));
+  if (list->rows == NULL || list->bound == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate %u rows", list->pool_size);
+    free(list->rows);
+    free(list->bound);
+    list->rows = NULL;
+    list->bound = NULL;
+    return false;
+  }
+
+  for (uint16_t i = 0; i < list->pool_size; i++) {
+    list->rows[i] = list->create_cb(obj, list->user_data);
+    lv_obj_add_flag(list->rows[i], LV_OBJ_FLAG_HIDDEN);
+    list->bound[i] = UNBOUND;
+  }
+  return true;
+}
+
+/**
+ * @brief Bind the rows to the items in view
+ *
+ * Item i always lives in row i % pool_size, so scrolling by one row
+ * rebinds exactly one widget.
+ */
+static void update_rows(lv_obj_t *obj, virtual_list_t *list, bool force) {
+  if (list->rows == NULL) {
+    return;
+  }
+
+  int32_t scroll_y = LV_MAX(lv_obj_get_scroll_y(obj), 0);
+  uint32_t first = scroll_y / list->pitch;
+
+  for (uint32_t i = first; i < first + list->pool_size; i++) {
+    uint16_t slot = i % list->pool_size;
+    lv_obj_t *row = list->rows[slot];
+
+    if (i >= list->count) {
+      lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+      list->bound[slot] = UNBOUND;
+      continue;
+    }
+
+    if (force || list->bound[slot] != i) {
+      lv_obj_set_y(row, (int32_t)i * list->pitch);
+      list->bind_cb(row, i, list->user_data);
+      list->bound[slot] = i;
+    }
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_HIDDEN);
+  }
+}
+
+static void virtual_list_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  virtual_list_t *list = lv_obj_get_user_data(obj);
+
+  if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+    free(list->rows);
+    free(list->bound);
+    free(list);
+    return;
+  }
+
+  // LV_EVENT_SCROLL
+  update_rows(obj, list, false);
+}
+
+lv_obj_t *virtual_list_create(lv_obj_t *parent, int32_t row_height,
+                              int32_t row_gap,
+                              virtual_list_create_cb_t create_cb,
+                              virtual_list_bind_cb_t bind_cb,
+                              void *user_data) {
+  if (create_cb == NULL || bind_cb == NULL || row_height <= 0) {
+    ESP_LOGE(TAG, "Invalid arguments");
+    return NULL;
+  }
+
+  virtual_list_t *list = calloc(1, sizeof(virtual_list_t));
+  if (list == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate list");
+    return NULL;
+  }
+  list->create_cb = create_cb;
+  list->bind_cb = bind_cb;
+  list->user_data = user_data;
+  list->row_height = row_height;
+  list->pitch = row_height + row_gap;
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_set_scroll_dir(obj, LV_DIR_VER);
+  lv_obj_set_user_data(obj, list);
+  lv_obj_add_event_cb(obj, virtual_list_event_cb, LV_EVENT_SCROLL, NULL);
+  lv_obj_add_event_cb(obj, virtual_list_event_cb, LV_EVENT_DELETE, NULL);
+
+  list->spacer = lv_obj_create(obj);
+  lv_obj_remove_style_all(list->spacer);
+  lv_obj_set_size(list->spacer, 1, 1);
+  lv_obj_clear_flag(list->spacer,
+                    LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+  return obj;
+}
+
+/**
+ * @brief Resize the content for a new count, scrolling by scroll_dy
+ */
+static void set_content(lv_obj_t *obj, virtual_list_t *list, uint32_t count,
+                        int32_t scroll_dy) {
+  list->count = count;
+  if (count > 0) {
+    lv_obj_set_y(list->spacer, (int32_t)(count - 1) * list->pitch +
+                                   list->row_height - 1);
+  } else {
+    lv_obj_set_y(list->spacer, 0);
+  }
+
+  // Keep the scroll position inside the new content
+  lv_obj_update_layout(obj);
+  lv_obj_scroll_to_y(obj, lv_obj_get_scroll_y(obj) + scroll_dy, LV_ANIM_OFF);
+}
+
+/**
+ * @brief Force the rows showing index and later items to rebind
+ */
+static void unbind_from(virtual_list_t *list, uint32_t index) {
+  for (uint16_t i = 0; i < list->pool_size; i++) {
+    if (list->bound[i] != UNBOUND && list->bound[i] >= index) {
+      list->bound[i] = UNBOUND;
+    }
+  }
+}
+
+/**
+ * @brief Item and scroll changes for an insert (+1) or removal (-1)
+ */
+static void shift_items(lv_obj_t *obj, uint32_t index, int32_t delta) {
+  virtual_list_t *list = lv_obj_get_user_data(obj);
+  if (list == NULL || !ensure_pool(obj, list)) {
+    return;
+  }
+
+  // Above the view: move the view with the items it shows
+  int32_t scroll_dy = 0;
+  if ((int32_t)index * list->pitch < lv_obj_get_scroll_y(obj)) {
+    scroll_dy = delta * list->pitch;
+  }
+
+  unbind_from(list, index);
+  set_content(obj, list, list->count + delta, scroll_dy);
+  update_rows(obj, list, false);
+}
+
+void virtual_list_set_count(lv_obj_t *obj, uint32_t count) {
+  virtual_list_t *list = lv_obj_get_user_data(obj);
+  if (list == NULL || !ensure_pool(obj, list)) {
+    return;
+  }
+
+  set_content(obj, list, count, 0);
+  update_rows(obj, list, true);
+}
+
+void virtual_list_insert(lv_obj_t *obj, uint32_t index) {
+  virtual_list_t *list = lv_obj_get_user_data(obj);
+  if (list == NULL || index > list->count) {
+    return;
+  }
+  shift_items(obj, index, 1);
+}
+
+void virtual_list_remove(lv_obj_t *obj, uint32_t index) {
+  virtual_list_t *list = lv_obj_get_user_data(obj);
+  if (list == NULL || index >= list->count) {
+    return;
+  }
+  shift_items(obj, index, -1);
+}
+
+uint32_t virtual_list_get_count(const lv_obj_t *obj) {
+  const virtual_list_t *list = lv_obj_get_user_data((lv_obj_t *)obj);
+  return (list != NULL) ? list->count : 0;
+}
@@ -0,0 +1,59 @@
+#ifndef VIRTUAL_LIST_H
+#define VIRTUAL_LIST_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+/**
+ * @brief Builds one (empty) row widget as a child of the list
+ *
+ * Set the row's size, x position and styles; the list sets y.
+ */
+typedef lv_obj_t *(*virtual_list_create_cb_t)(lv_obj_t *list, void *user_data);
+
+/**
+ * @brief Fills a row widget with the data of item index
+ */
+typedef void (*virtual_list_bind_cb_t)(lv_obj_t *row, uint32_t index,
+                                       void *user_data);
+
+/**
+ * @brief Create a vertically scrolling list of fixed-height rows
+ *
+ * Only enough row widgets to fill the viewport plus one are created; as
+ * the list scrolls, rows leaving the viewport are moved to the other end
+ * and rebound to the item that comes into view. Memory and per-frame cost
+ * stay the same whatever the item count.
+ */
+lv_obj_t *virtual_list_create(lv_obj_t *parent, int32_t row_height,
+                              int32_t row_gap,
+                              virtual_list_create_cb_t create_cb,
+                              virtual_list_bind_cb_t bind_cb,
+                              void *user_data);
+
+/**
+ * @brief Set the item count and rebind the visible rows
+ *
+ * Also call after the items changed without a count change.
+ */
+void virtual_list_set_count(lv_obj_t *list, uint32_t count);
+
+/**
+ * @brief An item was inserted at index (later items moved down by one)
+ *
+ * Only rows in view from index on are rebound. When the item lands above
+ * the view, the view scrolls with its content so nothing visible moves.
+ */
+void virtual_list_insert(lv_obj_t *list, uint32_t index);
+
+/**
+ * @brief The item at index was removed (later items moved up by one)
+ */
+void virtual_list_remove(lv_obj_t *list, uint32_t index);
+
+/**
+ * @brief Get the item count
+ */
+uint32_t virtual_list_get_count(const lv_obj_t *list);
+
+#endif // VIRTUAL_LIST_H
@@ -0,0 +1,391 @@
+#include "ui/widgets/watchface_engine.h"
+#include "esp_log.h"
+#include "ui/digit_atlas.h"
+#include "ui/layer_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "watchface_engine";
+
+typedef struct {
+  const watchface_face_t *face;
+  int32_t values[WATCHFACE_VALUE_SLOTS];
+  char texts[WATCHFACE_TEXT_SLOTS][WATCHFACE_TEXT_MAX];
+  bool ambient;
+  layer_cache_t layers[WATCHFACE_MAX_LAYERS];
+  digit_atlas_t atlas;  // For the DIGITS primitives
+  int16_t digits_prim;  // First DIGITS primitive (sets font/colour), or -1
+  bool digits_ready;    // Atlas matches the current look (this frame)
+  bool caches_pending;  // Re-render queued with lv_async_call()
+} watchface_state_t;
+
+/**
+ * @brief Area of a primitive relative to the widget, for a slot value
+ */
+static void prim_rel_area(const watchface_prim_t *prim, int32_t value,
+                          lv_area_t *area) {
+  int32_t x = prim->x;
+  if (prim->bind == WATCHFACE_BIND_TRACK) {
+    x += value * prim->step;
+  }
+
+  area->x1 = x;
+  area->y1 = prim->y;
+  area->x2 = x + prim->w - 1;
+  area->y2 = prim->y + prim->h - 1;
+}
+
+/**
+ * @brief Screen area of a primitive for the given value of its slot
+ */
+static void prim_area(lv_obj_t *obj, const watchface_prim_t *prim,
+                      int32_t value, lv_area_t *area) {
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  prim_rel_area(prim, value, area);
+  lv_area_move(area, coords.x1, coords.y1);
+}
+
+/**
+ * @brief Index of the static layer a primitive is baked into, or -1
+ */
+static int prim_layer(const watchface_face_t *face,
+                      const watchface_prim_t *prim) {
+  if (prim->bind != WATCHFACE_BIND_NONE) {
+    return -1;
+  }
+
+  lv_area_t area;
+  prim_rel_area(prim, 0, &area);
+  for (int i = 0; i < face->static_layer_count; i++) {
+    if (lv_area_is_in(&area, &face->static_layers[i], 0)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Draw a DIGITS primitive's text from the atlas if it can
+ */
+static bool draw_digits(lv_layer_t *layer, watchface_state_t *state,
+                        const watchface_prim_t *prim, int32_t x, int32_t y) {
+  const char *text = state->texts[prim->slot];
+  if (!state->digits_ready || prim->font != state->atlas.font ||
+      !digit_atlas_covers(text)) {
+    return false;
+  }
+
+  digit_atlas_draw(&state->atlas, layer, text, x + prim->x, y + prim->y);
+  return true;
+}
+
+/**
+ * @brief Draw a primitive with the widget's origin at x/y
+ */
+static void draw_prim(lv_layer_t *layer, const watchface_state_t *state,
+                      const watchface_prim_t *prim, int32_t x, int32_t y) {
+  int32_t value = (prim->bind == WATCHFACE_BIND_TEXT)
+                      ? 0
+                      : state->values[prim->slot];
+  lv_area_t area;
+  prim_rel_area(prim, value, &area);
+  lv_area_move(&area, x, y);
+
+  lv_area_t clipped;
+  if (!lv_area_intersect(&clipped, &area, &layer->_clip_area)) {
+    return;
+  }
+
+  const uint32_t *palette =
+      state->ambient ? state->face->ambient_palette : state->face->palette;
+  uint8_t color = prim->color;
+  if (prim->bind == WATCHFACE_BIND_LEVEL && value > prim->index) {
+    color = prim->color_on;
+  }
+
+  if (prim->type == WATCHFACE_PRIM_RECT) {
+    // LVGL's software renderer caches circle masks per radius itself
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(palette[color]);
+    dsc.radius = (prim->radius == WATCHFACE_RADIUS_CIRCLE) ? LV_RADIUS_CIRCLE
+                                                           : prim->radius;
+    lv_draw_rect(layer, &dsc, &area);
+  } else if (prim->type == WATCHFACE_PRIM_IMAGE) {
+    // Drawn over whatever it decorates, which shows if the image is missing
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = prim->text;
+    lv_draw_image(layer, &dsc, &area);
+  } else {
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = prim->font;
+    dsc.color = lv_color_hex(palette[color]);
+    dsc.text = (prim->bind == WATCHFACE_BIND_TEXT) ? state->texts[prim->slot]
+                                                   : prim->text;
+    lv_draw_label(layer, &dsc, &area);
+  }
+}
+
+/**
+ * @brief Theme/layout key the static layers depend on
+ *
+ * The layers hold the parent's background, so a theme change that
+ * recolours it (or a resize of the widget) makes them stale.
+ */
+static uint32_t layers_key(lv_obj_t *obj) {
+  lv_color_t bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), 0);
+  uint32_t key = lv_color_to_u32(bg);
+  key = key * 31 + (uint32_t)lv_obj_get_width(obj);
+  key = key * 31 + (uint32_t)lv_obj_get_height(obj);
+  return key;
+}
+
+typedef struct {
+  const watchface_state_t *state;
+  int layer;
+  lv_color_t bg;
+} layer_render_ctx_t;
+
+static void render_layer_cb(lv_layer_t *layer, int32_t x, int32_t y,
+                            void *user_data) {
+  const layer_render_ctx_t *ctx = user_data;
+  const watchface_face_t *face = ctx->state->face;
+
+  lv_draw_rect_dsc_t bg;
+  lv_draw_rect_dsc_init(&bg);
+  bg.bg_color = ctx->bg;
+  lv_draw_rect(layer, &bg, &layer->buf_area);
+
+  for (uint16_t i = 0; i < face->prim_count; i++) {
+    if (prim_layer(face, &face->prims[i]) == ctx->layer) {
+      draw_prim(layer, ctx->state, &face->prims[i], x, y);
+    }
+  }
+}
+
+static void render_caches_async_cb(void *user_data) {
+  lv_obj_t *obj = user_data;
+  watchface_state_t *state = lv_obj_get_user_data(obj);
+  state->caches_pending = false;
+
+  // Ambient mode hides the static primitives; only the normal look is cached
+  if (state->ambient) {
+    return;
+  }
+
+  if (state->digits_prim >= 0) {
+    const watchface_prim_t *prim = &state->face->prims[state->digits_prim];
+    lv_color_t fg = lv_color_hex(state->face->palette[prim->color]);
+    lv_color_t bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), 0);
+    if (!digit_atlas_matches(&state->atlas, prim->font,
+                             digit_atlas_key(fg, bg))) {
+      digit_atlas_init(&state->atlas, prim->font, fg, bg);
+    }
+  }
+
+  layer_render_ctx_t ctx = {
+      .state = state,
+      .bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), 0),
+  };
+  uint32_t key = layers_key(obj);
+  for (int i = 0; i < state->face->static_layer_count; i++) {
+    layer_cache_t *cache = &state->layers[i];
+    if (cache->valid && cache->key == key) {
+      continue;
+    }
+    ctx.layer = i;
+    if (layer_cache_render(cache, key, render_layer_cb, &ctx) != ESP_OK) {
+      return; // Keep drawing directly
+    }
+  }
+}
+
+static void watchface_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  watchface_state_t *state = lv_obj_get_user_data(obj);
+  lv_event_code_t code = lv_event_get_code(e);
+
+  if (code == LV_EVENT_DELETE) {
+    lv_async_call_cancel(render_caches_async_cb, obj);
+    for (int i = 0; i < WATCHFACE_MAX_LAYERS; i++) {
+      layer_cache_deinit(&state->layers[i]);
+    }
+    digit_atlas_deinit(&state->atlas);
+    free(state);
+    return;
+  }
+
+  if (code == LV_EVENT_SIZE_CHANGED) {
+    for (int i = 0; i < WATCHFACE_MAX_LAYERS; i++) {
+      layer_cache_invalidate(&state->layers[i]);
+    }
+    return;
+  }
+
+  // LV_EVENT_DRAW_MAIN
+  lv_layer_t *layer = lv_event_get_layer(e);
+  const watchface_face_t *face = state->face;
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+
+  // Static layers first; the ones that are stale get drawn directly this
+  // frame and re-rendered outside the refresh
+  bool layer_drawn[WATCHFACE_MAX_LAYERS] = {false};
+  state->digits_ready = false;
+  if (!state->ambient) {
+    uint32_t key = layers_key(obj);
+    bool stale = false;
+    for (int i = 0; i < face->static_layer_count; i++) {
+      layer_drawn[i] = layer_cache_draw(&state->layers[i], layer, coords.x1,
+                                        coords.y1, key);
+      stale |= !layer_drawn[i];
+    }
+
+    if (state->digits_prim >= 0) {
+      const watchface_prim_t *prim = &face->prims[state->digits_prim];
+      lv_color_t fg = lv_color_hex(face->palette[prim->color]);
+      lv_color_t bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), 0);
+      state->digits_ready = digit_atlas_matches(&state->atlas, prim->font,
+                                                digit_atlas_key(fg, bg));
+      stale |= !state->digits_ready;
+    }
+
+    if (stale && !state->caches_pending) {
+      state->caches_pending = true;
+      lv_async_call(render_caches_async_cb, obj);
+    }
+  }
+
+  for (uint16_t i = 0; i < face->prim_count; i++) {
+    const watchface_prim_t *prim = &face->prims[i];
+    if (state->ambient && !(prim->flags & WATCHFACE_FLAG_AMBIENT)) {
+      continue;
+    }
+    int baked = prim_layer(face, prim);
+    if (baked >= 0 && layer_drawn[baked]) {
+      continue;
+    }
+    if (prim->type == WATCHFACE_PRIM_DIGITS &&
+        draw_digits(layer, state, prim, coords.x1, coords.y1)) {
+      continue;
+    }
+    draw_prim(layer, state, prim, coords.x1, coords.y1);
+  }
+}
+
+lv_obj_t *watchface_engine_create(lv_obj_t *parent,
+                                  const watchface_face_t *face) {
+  if (face->static_layer_count > WATCHFACE_MAX_LAYERS) {
+    ESP_LOGE(TAG, "Too many static layers: %u", face->static_layer_count);
+    return NULL;
+  }
+
+  watchface_state_t *state = calloc(1, sizeof(watchface_state_t));
+  if (state == NULL) {
+    ESP_LOGE(TAG, "Failed to allocate face state");
+    return NULL;
+  }
+  state->face = face;
+  state->digits_prim = -1;
+  for (uint16_t i = 0; i < face->prim_count; i++) {
+    if (face->prims[i].type == WATCHFACE_PRIM_DIGITS) {
+      state->digits_prim = i;
+      break;
+    }
+  }
+  for (int i = 0; i < face->static_layer_count; i++) {
+    layer_cache_init(&state->layers[i], &face->static_layers[i]);
+  }
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_user_data(obj, state);
+  lv_obj_add_event_cb(obj, watchface_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, watchface_event_cb, LV_EVENT_SIZE_CHANGED, NULL);
+  lv_obj_add_event_cb(obj, watchface_event_cb, LV_EVENT_DELETE, NULL);
+
+  return obj;
+}
+
+void watchface_engine_set_value(lv_obj_t *obj, uint8_t slot, int32_t value) {
+  watchface_state_t *state = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (state == NULL || slot >= WATCHFACE_VALUE_SLOTS ||
+      state->values[slot] == value) {
+    return;
+  }
+
+  int32_t old = state->values[slot];
+  state->values[slot] = value;
+
+  const watchface_face_t *face = state->face;
+  for (uint16_t i = 0; i < face->prim_count; i++) {
+    const watchface_prim_t *prim = &face->prims[i];
+    if (prim->slot != slot || (state->ambient &&
+                               !(prim->flags & WATCHFACE_FLAG_AMBIENT))) {
+      continue;
+    }
+
+    lv_area_t area;
+    if (prim->bind == WATCHFACE_BIND_LEVEL) {
+      if ((old > prim->index) != (value > prim->index)) {
+        prim_area(obj, prim, value, &area);
+        lv_obj_invalidate_area(obj, &area);
+      }
+    } else if (prim->bind == WATCHFACE_BIND_TRACK) {
+      prim_area(obj, prim, old, &area);
+      lv_obj_invalidate_area(obj, &area);
+      prim_area(obj, prim, value, &area);
+      lv_obj_invalidate_area(obj, &area);
+    }
+  }
+}
+
+void watchface_engine_set_text(lv_obj_t *obj, uint8_t slot, const char *text) {
+  watchface_state_t *state = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (state == NULL || text == NULL || slot >= WATCHFACE_TEXT_SLOTS ||
+      strncmp(state->texts[slot], text, WATCHFACE_TEXT_MAX - 1) == 0) {
+    return;
+  }
+
+  // Characters before the first change keep their place
+  size_t same = 0;
+  while (text[same] != '\0' && text[same] == state->texts[slot][same]) {
+    same++;
+  }
+
+  char old_text[WATCHFACE_TEXT_MAX];
+  memcpy(old_text, state->texts[slot], sizeof(old_text));
+  strncpy(state->texts[slot], text, WATCHFACE_TEXT_MAX - 1);
+
+  const watchface_face_t *face = state->face;
+  for (uint16_t i = 0; i < face->prim_count; i++) {
+    const watchface_prim_t *prim = &face->prims[i];
+    if (prim->bind == WATCHFACE_BIND_TEXT && prim->slot == slot) {
+      lv_area_t area;
+      prim_area(obj, prim, 0, &area);
+      if (prim->type == WATCHFACE_PRIM_DIGITS) {
+        // "12:34" -> "12:35" redraws one digit cell, not the whole clock
+        area.x1 += digit_atlas_change_x(prim->font, old_text,
+                                        state->texts[slot], same);
+      }
+      if (area.x1 <= area.x2) {
+        lv_obj_invalidate_area(obj, &area);
+      }
+    }
+  }
+}
+
+void watchface_engine_set_ambient(lv_obj_t *obj, bool ambient) {
+  watchface_state_t *state = obj ? lv_obj_get_user_data(obj) : NULL;
+  if (state == NULL || state->ambient == ambient) {
+    return;
+  }
+
+  state->ambient = ambient;
+  lv_obj_invalidate(obj);
+}
@@ -0,0 +1,94 @@
+#ifndef WATCHFACE_ENGINE_H
+#define WATCHFACE_ENGINE_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define WATCHFACE_VALUE_SLOTS 8
+#define WATCHFACE_TEXT_SLOTS 4
+#define WATCHFACE_TEXT_MAX 24
+#define WATCHFACE_PALETTE_SIZE 8
+#define WATCHFACE_RADIUS_CIRCLE 0xFF
+#define WATCHFACE_MAX_LAYERS 4
+
+/**
+ * @brief Primitive kinds
+ */
+typedef enum {
+  WATCHFACE_PRIM_RECT,   // Filled (rounded) rectangle
+  WATCHFACE_PRIM_TEXT,   // Text from a slot, or static text
+  WATCHFACE_PRIM_DIGITS, // Clock text from a slot, drawn from a digit atlas
+  WATCHFACE_PRIM_IMAGE,  // Image source in text (e.g. ASSET_SRC("...")), box x/y/w/h
+} watchface_prim_type_t;
+
+/**
+ * @brief How a primitive follows the face's values
+ */
+typedef enum {
+  WATCHFACE_BIND_NONE,  // Static
+  WATCHFACE_BIND_LEVEL, // color_on while value[slot] > index, else color
+  WATCHFACE_BIND_TRACK, // Moved right by value[slot] * step pixels
+  WATCHFACE_BIND_TEXT,  // Shows text slot
+} watchface_bind_t;
+
+// Primitive flags
+#define WATCHFACE_FLAG_AMBIENT 0x01 // Also drawn in ambient mode
+
+/**
+ * @brief One primitive of a face (kept in a const table)
+ */
+typedef struct {
+  uint8_t type;     // watchface_prim_type_t
+  uint8_t bind;     // watchface_bind_t
+  uint8_t slot;     // Value or text slot
+  uint8_t index;    // LEVEL threshold
+  uint8_t radius;   // RECT corner radius (WATCHFACE_RADIUS_CIRCLE = round)
+  uint8_t color;    // Palette index
+  uint8_t color_on; // Palette index when a LEVEL primitive is lit
+  uint8_t flags;
+  int16_t x, y, w, h; // TEXT: box the text is drawn and invalidated in
+  int16_t step;       // TRACK pixels per value unit
+  const lv_font_t *font;
+  const char *text;   // Static TEXT (bind NONE), IMAGE source
+} watchface_prim_t;
+
+/**
+ * @brief Face description
+ */
+typedef struct {
+  const watchface_prim_t *prims;
+  uint16_t prim_count;
+  // Areas whose static primitives are baked, over the parent's background,
+  // into retained images (static = bind NONE and fully inside the area)
+  const lv_area_t *static_layers;
+  uint8_t static_layer_count;
+  uint32_t palette[WATCHFACE_PALETTE_SIZE];
+  uint32_t ambient_palette[WATCHFACE_PALETTE_SIZE]; // 8-colour safe
+} watchface_face_t;
+
+/**
+ * @brief Create the face as a single full-size object
+ *
+ * All primitives are drawn in one LV_EVENT_DRAW_MAIN handler; value
+ * changes only invalidate the primitives whose appearance changed. The
+ * parent must have an opaque background for the static layers.
+ */
+lv_obj_t *watchface_engine_create(lv_obj_t *parent, const watchface_face_t *face);
+
+/**
+ * @brief Set a value slot
+ */
+void watchface_engine_set_value(lv_obj_t *obj, uint8_t slot, int32_t value);
+
+/**
+ * @brief Set a text slot (copied, truncated to WATCHFACE_TEXT_MAX - 1)
+ */
+void watchface_engine_set_text(lv_obj_t *obj, uint8_t slot, const char *text);
+
+/**
+ * @brief Switch to the ambient palette and primitives
+ */
+void watchface_engine_set_ambient(lv_obj_t *obj, bool ambient);
+
+#endif // WATCHFACE_ENGINE_H
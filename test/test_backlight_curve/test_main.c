@@ -0,0 +1,82 @@
+#include "backlight_curve.h"
+#include <unity.h>
+
+#define FULL_SCALE_MS 510 // 2 ms per level
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_duty_end_points(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, backlight_curve_duty(0));
+  TEST_ASSERT_EQUAL_UINT32(BACKLIGHT_DUTY_MAX, backlight_curve_duty(255));
+}
+
+static void test_duty_monotonic(void) {
+  for (int level = 1; level <= 255; level++) {
+    TEST_ASSERT_GREATER_THAN(backlight_curve_duty(level - 1),
+                             backlight_curve_duty(level));
+  }
+}
+
+static void test_level_round_trip(void) {
+  for (int level = 0; level <= 255; level++) {
+    TEST_ASSERT_EQUAL_UINT8(level,
+                            backlight_curve_level(backlight_curve_duty(level)));
+  }
+  // Off-curve duties go to the nearest level, and saturate at the top
+  uint32_t mid =
+      (backlight_curve_duty(100) * 3 + backlight_curve_duty(101)) / 4;
+  TEST_ASSERT_EQUAL_UINT8(100, backlight_curve_level(mid));
+  TEST_ASSERT_EQUAL_UINT8(255, backlight_curve_level(BACKLIGHT_DUTY_MAX + 100));
+}
+
+static void test_fade_duration_proportional(void) {
+  backlight_fade_plan_t plan;
+
+  backlight_curve_plan_fade(0, 255, FULL_SCALE_MS, &plan);
+  TEST_ASSERT_EQUAL_UINT32(BACKLIGHT_DUTY_MAX, plan.target_duty);
+  TEST_ASSERT_EQUAL_UINT32(FULL_SCALE_MS, plan.duration_ms);
+
+  // Same speed both ways and for shorter moves
+  backlight_curve_plan_fade(backlight_curve_duty(200), 100, FULL_SCALE_MS,
+                            &plan);
+  TEST_ASSERT_EQUAL_UINT32(backlight_curve_duty(100), plan.target_duty);
+  TEST_ASSERT_EQUAL_UINT32(200, plan.duration_ms);
+  backlight_curve_plan_fade(backlight_curve_duty(100), 200, FULL_SCALE_MS,
+                            &plan);
+  TEST_ASSERT_EQUAL_UINT32(200, plan.duration_ms);
+
+  // No move, or no fade time: applied immediately
+  backlight_curve_plan_fade(backlight_curve_duty(80), 80, FULL_SCALE_MS, &plan);
+  TEST_ASSERT_EQUAL_UINT32(0, plan.duration_ms);
+  backlight_curve_plan_fade(0, 255, 0, &plan);
+  TEST_ASSERT_EQUAL_UINT32(BACKLIGHT_DUTY_MAX, plan.target_duty);
+  TEST_ASSERT_EQUAL_UINT32(0, plan.duration_ms);
+}
+
+static void test_fade_interrupted_partway(void) {
+  backlight_fade_plan_t plan;
+
+  // A 0 -> 255 fade reversed when the hardware duty is at level 60: the
+  // fade back only covers the 60 levels already climbed
+  backlight_curve_plan_fade(backlight_curve_duty(60), 0, FULL_SCALE_MS, &plan);
+  TEST_ASSERT_EQUAL_UINT32(0, plan.target_duty);
+  TEST_ASSERT_EQUAL_UINT32(120, plan.duration_ms);
+
+  // Interrupted between two levels: timed from the nearest one
+  uint32_t between =
+      (backlight_curve_duty(150) + backlight_curve_duty(151) * 3) / 4;
+  backlight_curve_plan_fade(between, 255, FULL_SCALE_MS, &plan);
+  TEST_ASSERT_EQUAL_UINT32(BACKLIGHT_DUTY_MAX, plan.target_duty);
+  TEST_ASSERT_EQUAL_UINT32((255 - 151) * 2, plan.duration_ms);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_duty_end_points);
+  RUN_TEST(test_duty_monotonic);
+  RUN_TEST(test_level_round_trip);
+  RUN_TEST(test_fade_duration_proportional);
+  RUN_TEST(test_fade_interrupted_partway);
+  return UNITY_END();
+}
@@ -0,0 +1,185 @@
+#include "rle565.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#define ROW_PX 240
+
+static uint16_t row[ROW_PX];
+static uint16_t decoded[ROW_PX];
+static uint8_t encoded[RLE565_MAX_ENCODED_SIZE(ROW_PX)];
+
+/**
+ * @brief Encode, decode over prev and return the encoded size
+ */
+static size_t round_trip(const uint16_t *px, const uint16_t *prev,
+                         const rle565_skip_t *skips, size_t skip_count) {
+  size_t len = rle565_encode(px, ROW_PX, skips, skip_count, encoded,
+                             sizeof(encoded));
+  TEST_ASSERT_TRUE(len > 0);
+  TEST_ASSERT_TRUE(len <= RLE565_MAX_ENCODED_SIZE(ROW_PX));
+
+  memcpy(decoded, prev, sizeof(decoded));
+  TEST_ASSERT_EQUAL_size_t(len,
+                           rle565_decode(encoded, len, decoded, ROW_PX));
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(px, decoded, ROW_PX);
+  return len;
+}
+
+static void fill_ui_row(uint16_t *px) {
+  // Background, a rounded card edge and some anti-aliased text pixels
+  for (int x = 0; x < ROW_PX; x++) {
+    px[x] = 0xC618;
+  }
+  for (int x = 12; x < 228; x++) {
+    px[x] = 0x18E3;
+  }
+  const uint16_t glyph[] = {0x2124, 0x8C71, 0xF79E, 0xF79E, 0x52AA, 0x18E3};
+  for (int x = 30; x < 150; x += 8) {
+    memcpy(&px[x], glyph, sizeof(glyph));
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_flat_row_uses_runs(void) {
+  static uint16_t zero[ROW_PX];
+  for (int x = 0; x < ROW_PX; x++) {
+    row[x] = 0xF800;
+  }
+  // 240 pixels = 4 runs of at most 64, 3 bytes each
+  TEST_ASSERT_EQUAL_size_t(12, round_trip(row, zero, NULL, 0));
+  TEST_ASSERT_EQUAL_HEX8(RLE565_OP_RUN | 63, encoded[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x00, encoded[1]);
+  TEST_ASSERT_EQUAL_HEX8(0xF8, encoded[2]);
+}
+
+static void test_ui_row_round_trips(void) {
+  static uint16_t zero[ROW_PX];
+  fill_ui_row(row);
+  size_t len = round_trip(row, zero, NULL, 0);
+  TEST_ASSERT_TRUE(len < ROW_PX); // Under half the raw 480 bytes
+}
+
+static void test_skips_keep_previous_content(void) {
+  uint16_t prev[ROW_PX];
+  fill_ui_row(prev);
+  memcpy(row, prev, sizeof(row));
+  for (int x = 64; x < 80; x++) {
+    row[x] = (uint16_t)(x * 977); // Changed block
+  }
+
+  // Everything but the changed block is skipped, like display_mirror does
+  const rle565_skip_t skips[] = {{0, 64}, {80, 160}};
+  size_t len = round_trip(row, prev, skips, 2);
+  TEST_ASSERT_TRUE(len <= 1 + 1 + 16 * 2 + 3);
+
+  // Skipped pixels really come from prev, not from the input
+  uint16_t stale[ROW_PX];
+  memcpy(stale, prev, sizeof(stale));
+  stale[10] ^= 0xFFFF;
+  len = rle565_encode(row, ROW_PX, skips, 2, encoded, sizeof(encoded));
+  memcpy(decoded, stale, sizeof(decoded));
+  TEST_ASSERT_EQUAL_size_t(len, rle565_decode(encoded, len, decoded, ROW_PX));
+  TEST_ASSERT_EQUAL_UINT16(stale[10], decoded[10]);
+}
+
+static void test_long_and_edge_skips(void) {
+  uint16_t prev[ROW_PX];
+  fill_ui_row(prev);
+  memcpy(row, prev, sizeof(row));
+  row[0] = 0x1234;
+  row[ROW_PX - 1] = 0x4321;
+
+  // Skip longer than one op, and a skip ending at the last pixel
+  const rle565_skip_t skips[] = {{1, 200}, {230, 9}};
+  round_trip(row, prev, skips, 2);
+
+  const rle565_skip_t all[] = {{0, ROW_PX}};
+  memcpy(row, prev, sizeof(row));
+  TEST_ASSERT_EQUAL_size_t(4, round_trip(row, prev, all, 1));
+}
+
+static void test_random_rows_round_trip(void) {
+  uint16_t prev[ROW_PX];
+  srand(1);
+  for (int iter = 0; iter < 500; iter++) {
+    for (int x = 0; x < ROW_PX; x++) {
+      prev[x] = (uint16_t)rand();
+      // Mix noise with runs of a few colours
+      row[x] = (rand() % 4 == 0) ? (uint16_t)rand() : (uint16_t)(rand() % 3);
+    }
+
+    rle565_skip_t skips[8];
+    size_t skip_count = 0;
+    size_t x = rand() % 20;
+    while (skip_count < 8 && x < ROW_PX) {
+      size_t len = 1 + rand() % 90;
+      if (x + len > ROW_PX) {
+        len = ROW_PX - x;
+      }
+      skips[skip_count++] = (rle565_skip_t){(uint16_t)x, (uint16_t)len};
+      for (size_t k = x; k < x + len; k++) {
+        row[k] = prev[k]; // Skipped pixels match what the decoder has
+      }
+      x += len + 1 + rand() % 40;
+    }
+    round_trip(row, prev, skips, skip_count);
+  }
+}
+
+static void test_small_buffer_fails(void) {
+  for (int x = 0; x < ROW_PX; x++) {
+    row[x] = (uint16_t)(x * 31337);
+  }
+  size_t full = rle565_encode(row, ROW_PX, NULL, 0, encoded, sizeof(encoded));
+  TEST_ASSERT_EQUAL_size_t(RLE565_MAX_ENCODED_SIZE(ROW_PX), full);
+  TEST_ASSERT_EQUAL_size_t(
+      0, rle565_encode(row, ROW_PX, NULL, 0, encoded, full - 1));
+}
+
+static void test_bad_skips_rejected(void) {
+  const rle565_skip_t unsorted[] = {{100, 10}, {50, 10}};
+  TEST_ASSERT_EQUAL_size_t(
+      0, rle565_encode(row, ROW_PX, unsorted, 2, encoded, sizeof(encoded)));
+  const rle565_skip_t past_end[] = {{230, 20}};
+  TEST_ASSERT_EQUAL_size_t(
+      0, rle565_encode(row, ROW_PX, past_end, 1, encoded, sizeof(encoded)));
+}
+
+static void test_malformed_input_rejected(void) {
+  // Truncated literal
+  const uint8_t short_lit[] = {RLE565_OP_LIT | 3, 0x00, 0xF8, 0x00};
+  TEST_ASSERT_EQUAL_size_t(0, rle565_decode(short_lit, sizeof(short_lit),
+                                            decoded, 4));
+  // Truncated run value
+  const uint8_t short_run[] = {RLE565_OP_RUN | 3, 0x00};
+  TEST_ASSERT_EQUAL_size_t(0, rle565_decode(short_run, sizeof(short_run),
+                                            decoded, 4));
+  // Reserved op type
+  const uint8_t bad_op[] = {0xC3};
+  TEST_ASSERT_EQUAL_size_t(0, rle565_decode(bad_op, sizeof(bad_op), decoded,
+                                            4));
+  // More pixels than the rectangle has
+  const uint8_t overrun[] = {RLE565_OP_SKIP | 7};
+  TEST_ASSERT_EQUAL_size_t(0, rle565_decode(overrun, sizeof(overrun),
+                                            decoded, 4));
+  // Too few pixels
+  const uint8_t underrun[] = {RLE565_OP_SKIP | 1};
+  TEST_ASSERT_EQUAL_size_t(0, rle565_decode(underrun, sizeof(underrun),
+                                            decoded, 4));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_flat_row_uses_runs);
+  RUN_TEST(test_ui_row_round_trips);
+  RUN_TEST(test_skips_keep_previous_content);
+  RUN_TEST(test_long_and_edge_skips);
+  RUN_TEST(test_random_rows_round_trip);
+  RUN_TEST(test_small_buffer_fails);
+  RUN_TEST(test_bad_skips_rejected);
+  RUN_TEST(test_malformed_input_rejected);
+  return UNITY_END();
+}
@@ -0,0 +1,278 @@
+#include "st7789_scroll.h"
+#include <string.h>
+#include <unity.h>
+
+// 240x280 glass in the middle of the 320-row RAM, as on the watch
+#define V_RES 280
+#define Y_GAP 20
+#define RAM_ROWS 320
+#define LOG_SIZE 64
+
+typedef struct {
+  uint8_t cmd;
+  uint8_t params[6];
+  size_t len;
+} sent_cmd_t;
+
+/**
+ * @brief Fake panel: records commands and models RAM rows and scanning
+ *
+ * Each RAM row holds one value standing in for its pixels. MADCTL row
+ * mirroring stores RASET row r at physical row RAM_ROWS-1-r; display
+ * line L shows physical row L, rotated inside the VSCRDEF area by VSCSAD.
+ */
+typedef struct {
+  bool mirror_y;
+  sent_cmd_t log[LOG_SIZE];
+  size_t log_count;
+  uint16_t ram[RAM_ROWS];
+  uint16_t ys, ye; // RASET window
+  uint16_t tfa, vsa, vsp;
+} fake_panel_t;
+
+static fake_panel_t panel;
+static st7789_scroll_t scroll;
+
+static uint16_t be16(const uint8_t *p) { return (uint16_t)(p[0] << 8 | p[1]); }
+
+static int fake_tx(void *ctx, uint8_t cmd, const uint8_t *params, size_t len) {
+  fake_panel_t *p = ctx;
+  TEST_ASSERT_TRUE(p->log_count < LOG_SIZE);
+  TEST_ASSERT_TRUE(len <= sizeof(p->log[0].params));
+  sent_cmd_t *sent = &p->log[p->log_count++];
+  sent->cmd = cmd;
+  sent->len = len;
+  memcpy(sent->params, params, len);
+
+  switch (cmd) {
+  case ST7789_CMD_RASET:
+    p->ys = be16(params);
+    p->ye = be16(params + 2);
+    break;
+  case ST7789_CMD_VSCRDEF:
+    p->tfa = be16(params);
+    p->vsa = be16(params + 2);
+    TEST_ASSERT_EQUAL_UINT16(RAM_ROWS, p->tfa + p->vsa + be16(params + 4));
+    break;
+  case ST7789_CMD_VSCSAD:
+    p->vsp = be16(params);
+    break;
+  }
+  return 0;
+}
+
+static void fake_init(bool mirror_y) {
+  memset(&panel, 0, sizeof(panel));
+  panel.mirror_y = mirror_y;
+  panel.vsa = RAM_ROWS;
+  st7789_scroll_init(&scroll, 0, Y_GAP, RAM_ROWS, mirror_y);
+}
+
+static void fake_ramwr(const uint16_t *values, uint16_t rows) {
+  TEST_ASSERT_EQUAL_UINT16(panel.ye - panel.ys + 1, rows);
+  for (uint16_t i = 0; i < rows; i++) {
+    uint16_t r = panel.ys + i;
+    panel.ram[panel.mirror_y ? RAM_ROWS - 1 - r : r] = values[i];
+  }
+}
+
+/**
+ * @brief What the glass shows at an LVGL row
+ */
+static uint16_t fake_visible(uint16_t row) {
+  uint16_t line = panel.mirror_y ? RAM_ROWS - 1 - Y_GAP - row : row + Y_GAP;
+  if (line >= panel.tfa && line < panel.tfa + panel.vsa) {
+    line = panel.tfa + (line - panel.tfa + panel.vsp - panel.tfa) % panel.vsa;
+  }
+  return panel.ram[line];
+}
+
+/**
+ * @brief Write LVGL rows y1..y2 the way the flush does
+ */
+static void flush_rows(int y1, int y2, uint16_t (*content)(int)) {
+  int y = y1;
+  while (y <= y2) {
+    uint16_t raset;
+    uint16_t rows = st7789_scroll_find_run(&scroll, y, y2, &raset);
+    uint16_t values[RAM_ROWS];
+    for (uint16_t i = 0; i < rows; i++) {
+      values[i] = content(y + i);
+    }
+    st7789_scroll_send_window(&scroll, 0, 239, raset, rows, fake_tx, &panel);
+    fake_ramwr(values, rows);
+    y += rows;
+  }
+}
+
+// Content of a list scrolled to a position
+static int list_pos;
+static uint16_t list_row(int y) { return (uint16_t)(1000 + y - list_pos); }
+
+static void assert_list_visible(void) {
+  for (int y = 0; y < V_RES; y++) {
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(list_row(y), fake_visible(y), "row");
+  }
+}
+
+static void assert_sent(size_t index, uint8_t cmd, const uint8_t *params,
+                        size_t len) {
+  TEST_ASSERT_TRUE(index < panel.log_count);
+  TEST_ASSERT_EQUAL_HEX8(cmd, panel.log[index].cmd);
+  TEST_ASSERT_EQUAL_size_t(len, panel.log[index].len);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(params, panel.log[index].params, len);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_row_mapping_applies_gap(void) {
+  fake_init(true);
+  TEST_ASSERT_EQUAL_UINT16(299, st7789_scroll_row_to_line(&scroll, 0));
+  TEST_ASSERT_EQUAL_UINT16(20, st7789_scroll_row_to_line(&scroll, 279));
+  TEST_ASSERT_EQUAL_UINT16(20, st7789_scroll_row_to_raset(&scroll, 0));
+  TEST_ASSERT_EQUAL_UINT16(299, st7789_scroll_row_to_raset(&scroll, 279));
+
+  fake_init(false);
+  TEST_ASSERT_EQUAL_UINT16(20, st7789_scroll_row_to_line(&scroll, 0));
+  TEST_ASSERT_EQUAL_UINT16(299, st7789_scroll_row_to_line(&scroll, 279));
+}
+
+static void test_window_bytes(void) {
+  fake_init(true);
+  st7789_scroll_send_window(&scroll, 10, 229, 20, 50, fake_tx, &panel);
+  TEST_ASSERT_EQUAL_size_t(2, panel.log_count);
+  assert_sent(0, ST7789_CMD_CASET, (const uint8_t[]){0, 10, 0, 229}, 4);
+  assert_sent(1, ST7789_CMD_RASET, (const uint8_t[]){0, 20, 0, 69}, 4);
+}
+
+static void test_full_screen_area_bytes(void) {
+  fake_init(true);
+  st7789_scroll_define(&scroll, 0, V_RES, fake_tx, &panel);
+  TEST_ASSERT_EQUAL_size_t(2, panel.log_count);
+  // TFA 20, VSA 280, BFA 20: the gap rows stay out of the ring
+  assert_sent(0, ST7789_CMD_VSCRDEF, (const uint8_t[]){0, 20, 1, 24, 0, 20},
+              6);
+  assert_sent(1, ST7789_CMD_VSCSAD, (const uint8_t[]){0, 20}, 2);
+
+  // Content down 10 rows: mirrored, the start line moves up in RAM order
+  st7789_scroll_move(&scroll, 10);
+  TEST_ASSERT_EQUAL_UINT16(270, scroll.offset);
+  st7789_scroll_send_start(&scroll, fake_tx, &panel);
+  assert_sent(2, ST7789_CMD_VSCSAD, (const uint8_t[]){0, 30}, 2);
+
+  // Unmirrored, the same move goes the other way
+  fake_init(false);
+  st7789_scroll_define(&scroll, 0, V_RES, fake_tx, &panel);
+  st7789_scroll_move(&scroll, 10);
+  st7789_scroll_send_start(&scroll, fake_tx, &panel);
+  assert_sent(2, ST7789_CMD_VSCSAD, (const uint8_t[]){1, 34}, 2);
+}
+
+static void test_sub_area_bytes(void) {
+  fake_init(true);
+  // Rows 40..239 are lines 60..259 when mirrored
+  st7789_scroll_define(&scroll, 40, 200, fake_tx, &panel);
+  assert_sent(0, ST7789_CMD_VSCRDEF, (const uint8_t[]){0, 60, 0, 200, 0, 60},
+              6);
+
+  st7789_scroll_define(&scroll, 0, 0, fake_tx, &panel);
+  assert_sent(2, ST7789_CMD_VSCRDEF, (const uint8_t[]){0, 0, 1, 64, 0, 0}, 6);
+  assert_sent(3, ST7789_CMD_VSCSAD, (const uint8_t[]){0, 0}, 2);
+}
+
+static void test_raset_wraps_around(void) {
+  fake_init(true);
+  st7789_scroll_define(&scroll, 40, 200, fake_tx, &panel);
+  st7789_scroll_move(&scroll, -150);
+  TEST_ASSERT_EQUAL_UINT16(150, scroll.offset);
+
+  // Outside the area: plain gap offset
+  TEST_ASSERT_EQUAL_UINT16(59, st7789_scroll_row_to_raset(&scroll, 39));
+  TEST_ASSERT_EQUAL_UINT16(260, st7789_scroll_row_to_raset(&scroll, 240));
+  // Inside: rotated, wrapping at the end of the area
+  TEST_ASSERT_EQUAL_UINT16(210, st7789_scroll_row_to_raset(&scroll, 40));
+  TEST_ASSERT_EQUAL_UINT16(259, st7789_scroll_row_to_raset(&scroll, 89));
+  TEST_ASSERT_EQUAL_UINT16(60, st7789_scroll_row_to_raset(&scroll, 90));
+
+  // A flush across the wrap splits into two RAM writes
+  uint16_t raset;
+  TEST_ASSERT_EQUAL_UINT16(50, st7789_scroll_find_run(&scroll, 40, 239,
+                                                      &raset));
+  TEST_ASSERT_EQUAL_UINT16(210, raset);
+  TEST_ASSERT_EQUAL_UINT16(150, st7789_scroll_find_run(&scroll, 90, 279,
+                                                       &raset));
+  TEST_ASSERT_EQUAL_UINT16(60, raset);
+
+  st7789_scroll_move(&scroll, -50);
+  TEST_ASSERT_EQUAL_UINT16(0, scroll.offset);
+  st7789_scroll_move(&scroll, 450);
+  TEST_ASSERT_EQUAL_UINT16(150, scroll.offset);
+}
+
+/**
+ * @brief Scroll like a list: only the exposed rows are redrawn
+ */
+static void scroll_list(int lines, int top, int height) {
+  list_pos += lines;
+  st7789_scroll_move(&scroll, lines);
+  if (lines > 0) {
+    flush_rows(top, top + lines - 1, list_row);
+  } else {
+    flush_rows(top + height + lines, top + height - 1, list_row);
+  }
+  st7789_scroll_send_start(&scroll, fake_tx, &panel);
+}
+
+static void check_scrolled_image(bool mirror_y) {
+  fake_init(mirror_y);
+  list_pos = 0;
+  flush_rows(0, V_RES - 1, list_row);
+  st7789_scroll_define(&scroll, 0, V_RES, fake_tx, &panel);
+  assert_list_visible();
+
+  const int steps[] = {10, 25, -7, -60, 279, -279, 140, 1, -1, -133};
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    scroll_list(steps[i], 0, V_RES);
+    assert_list_visible();
+  }
+}
+
+static void test_scrolled_image_mirrored(void) { check_scrolled_image(true); }
+
+static void test_scrolled_image_unmirrored(void) {
+  check_scrolled_image(false);
+}
+
+// Fixed header and footer around a scrolling list
+static uint16_t framed_row(int y) {
+  return (y < 40 || y >= 240) ? (uint16_t)(5000 + y) : list_row(y);
+}
+
+static void test_scrolled_sub_area_keeps_fixed_rows(void) {
+  fake_init(true);
+  list_pos = 0;
+  flush_rows(0, V_RES - 1, framed_row);
+  st7789_scroll_define(&scroll, 40, 200, fake_tx, &panel);
+
+  const int steps[] = {30, 199, -45, -200, 3};
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    scroll_list(steps[i], 40, 200);
+    for (int y = 0; y < V_RES; y++) {
+      TEST_ASSERT_EQUAL_UINT16(framed_row(y), fake_visible(y));
+    }
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_row_mapping_applies_gap);
+  RUN_TEST(test_window_bytes);
+  RUN_TEST(test_full_screen_area_bytes);
+  RUN_TEST(test_sub_area_bytes);
+  RUN_TEST(test_raset_wraps_around);
+  RUN_TEST(test_scrolled_image_mirrored);
+  RUN_TEST(test_scrolled_image_unmirrored);
+  RUN_TEST(test_scrolled_sub_area_keeps_fixed_rows);
+  return UNITY_END();
+}
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""Pack PNG images into an asset pack for src/ui/asset_pack.c.
+
+Every image is converted to the RGB565 layout LVGL renders in (and the
+flush path sends unchanged), with an A8 plane when it has transparency,
+so nothing is converted at runtime. Images that run-length code well are
+stored compressed (the lib/rle565 format); the rest are stored raw and
+drawn straight from memory-mapped flash.
+
+    python tools/asset_pack.py -o assets.bin assets/*.png
+    python tools/asset_pack.py -o assets.bin launcher_settings=settings.png
+    python tools/asset_pack.py -o assets.bin --atlas app_icons icons/*.png
+
+The asset name is the file name without extension unless given as
+name=path. --atlas packs its images side by side into one image (always
+stored raw) and each image becomes a region of it, looked up with
+asset_pack_get_region() and drawn as a sub-rect of the atlas. Write the
+pack to the "assets" partition with
+
+    parttool.py write_partition --partition-name assets --input assets.bin
+
+Requires Pillow.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"AST1"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<24sIIHHBBH")
+NAME_MAX = 23
+ALIGN = 4
+
+# lv_color_format_t values
+CF_RGB565 = 0x12
+CF_RGB565A8 = 0x14
+
+COMPRESS_NONE = 0
+COMPRESS_RLE = 1
+REGION = 2  # No data: offset = atlas index, size = y << 16 | x
+
+ATLAS_WIDTH = 256
+
+OP_RUN = 0x40
+OP_LIT = 0x80
+MAX_COUNT = 64
+MIN_RUN = 3
+
+
+def run_length(px, i):
+    n = 1
+    while i + n < len(px) and n < MAX_COUNT and px[i + n] == px[i]:
+        n += 1
+    return n
+
+
+def rle565_encode(px):
+    """Mirrors encode_span() in lib/rle565 (no skips)."""
+    out = bytearray()
+    i = 0
+    while i < len(px):
+        run = run_length(px, i)
+        if run >= MIN_RUN:
+            out += struct.pack("<BH", OP_RUN | (run - 1), px[i])
+            i += run
+            continue
+        lit = 0
+        while (i + lit < len(px) and lit < MAX_COUNT and
+               run_length(px, i + lit) < MIN_RUN):
+            lit += 1
+        lit = max(lit, 1)
+        out.append(OP_LIT | (lit - 1))
+        out += struct.pack("<%dH" % lit, *px[i:i + lit])
+        i += lit
+    return bytes(out)
+
+
+def to_rgb565(r, g, b):
+    return (((r * 31 + 127) // 255) << 11 | ((g * 63 + 127) // 255) << 5 |
+            ((b * 31 + 127) // 255))
+
+
+def load(path):
+    from PIL import Image
+
+    return Image.open(path).convert("RGBA")
+
+
+def convert(image, path):
+    """Return (w, h, cf, planes) with planes as lists of 16-bit words."""
+    w, h = image.size
+    if w > 0xFFFF or h > 0xFFFF:
+        raise ValueError("%s: image too large" % path)
+    data = image.tobytes()
+    color = [to_rgb565(data[i], data[i + 1], data[i + 2])
+             for i in range(0, len(data), 4)]
+    alpha = bytes(data[3::4])
+    if all(a == 255 for a in alpha):
+        return w, h, CF_RGB565, [color]
+
+    # The A8 plane is coded as little-endian byte pairs, padded to even
+    if len(alpha) % 2:
+        alpha += b"\0"
+    pairs = list(struct.unpack("<%dH" % (len(alpha) // 2), alpha))
+    return w, h, CF_RGB565A8, [color, pairs]
+
+
+def encode(planes, mode):
+    raw = b"".join(struct.pack("<%dH" % len(p), *p) for p in planes)
+    if mode == "none":
+        return COMPRESS_NONE, raw
+    packed = b"".join(rle565_encode(p) for p in planes)
+    # Raw assets are drawn in place, so only compress when it pays well
+    if mode == "rle" or len(packed) * 2 <= len(raw):
+        return COMPRESS_RLE, packed
+    return COMPRESS_NONE, raw
+
+
+def check_name(name):
+    if not name or len(name.encode()) > NAME_MAX:
+        raise ValueError("%s: name must be 1-%d bytes" % (name, NAME_MAX))
+    return name
+
+
+def parse_input(text):
+    if "=" in text:
+        name, path = text.split("=", 1)
+    else:
+        path = text
+        name = os.path.splitext(os.path.basename(path))[0]
+    return check_name(name), path
+
+
+def layout_atlas(images):
+    """Place images left to right in shelves; return positions and size."""
+    positions = []
+    x = y = shelf_h = width = 0
+    for image in images:
+        w, h = image.size
+        if x > 0 and x + w > ATLAS_WIDTH:
+            x, y, shelf_h = 0, y + shelf_h, 0
+        positions.append((x, y))
+        x += w
+        shelf_h = max(shelf_h, h)
+        width = max(width, x)
+    return positions, width, y + shelf_h
+
+
+def add_image(assets, name, image, path, mode):
+    w, h, cf, planes = convert(image, path)
+    compression, blob = encode(planes, mode)
+    raw_size = w * h * (3 if cf == CF_RGB565A8 else 2)
+    assets.append({"name": name, "w": w, "h": h, "cf": cf,
+                   "compression": compression, "blob": blob,
+                   "raw_size": raw_size})
+
+
+def build(inputs, atlases, mode):
+    from PIL import Image
+
+    assets = []
+    for name, path in inputs:
+        add_image(assets, name, load(path), path, mode)
+
+    for atlas_name, members in atlases:
+        images = [load(path) for _, path in members]
+        positions, w, h = layout_atlas(images)
+        atlas = Image.new("RGBA", (w, h), (0, 0, 0, 0))
+        for image, pos in zip(images, positions):
+            atlas.paste(image, pos)
+        # Raw so it is drawn in place and never needs a decoded copy
+        add_image(assets, atlas_name, atlas, atlas_name, "none")
+        cf = assets[-1]["cf"]
+        for (name, _), image, (x, y) in zip(members, images, positions):
+            assets.append({"name": name, "w": image.size[0],
+                           "h": image.size[1], "cf": cf,
+                           "compression": REGION, "blob": b"",
+                           "raw_size": 0, "atlas": atlas_name,
+                           "x": x, "y": y})
+
+    assets.sort(key=lambda a: a["name"])
+    names = [a["name"] for a in assets]
+    if len(set(names)) != len(names):
+        raise ValueError("duplicate asset names")
+
+    offset = HEADER.size + ENTRY.size * len(assets)
+    index = bytearray()
+    data = bytearray()
+    for a in assets:
+        if a["compression"] == REGION:
+            index += ENTRY.pack(a["name"].encode(), names.index(a["atlas"]),
+                                a["y"] << 16 | a["x"], a["w"], a["h"],
+                                a["cf"], REGION, 0)
+            continue
+        pad = -(offset + len(data)) % ALIGN
+        data += b"\0" * pad
+        index += ENTRY.pack(a["name"].encode(), offset + len(data),
+                            len(a["blob"]), a["w"], a["h"], a["cf"],
+                            a["compression"], 0)
+        data += a["blob"]
+
+    total = offset + len(data)
+    header = HEADER.pack(MAGIC, VERSION, len(assets), offset, total)
+    return header + bytes(index) + bytes(data), assets
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("inputs", nargs="*", help="[name=]image.png")
+    parser.add_argument("-o", "--out", required=True)
+    parser.add_argument("--compress", choices=("auto", "rle", "none"),
+                        default="auto",
+                        help="auto: RLE only when it halves the size")
+    parser.add_argument("--atlas", nargs="+", action="append", default=[],
+                        metavar="ARG",
+                        help="NAME [name=]image.png...: pack into one atlas")
+    args = parser.parse_args()
+    if not args.inputs and not args.atlas:
+        parser.error("no images")
+    if any(len(a) < 2 for a in args.atlas):
+        parser.error("--atlas needs a name and images")
+
+    try:
+        atlases = [(check_name(a[0]),
+                    [parse_input(i) for i in a[1:]]) for a in args.atlas]
+        pack, assets = build([parse_input(i) for i in args.inputs], atlases,
+                             args.compress)
+    except (OSError, ValueError) as err:
+        sys.exit("asset_pack: %s" % err)
+
+    with open(args.out, "wb") as out:
+        out.write(pack)
+
+    for a in assets:
+        if a["compression"] == REGION:
+            print("%-24s %3dx%-3d in %s at %d,%d" % (
+                a["name"], a["w"], a["h"], a["atlas"], a["x"], a["y"]))
+            continue
+        print("%-24s %3dx%-3d %-8s %6d -> %6d bytes%s" % (
+            a["name"], a["w"], a["h"],
+            "RGB565A8" if a["cf"] == CF_RGB565A8 else "RGB565",
+            a["raw_size"], len(a["blob"]),
+            " (rle)" if a["compression"] == COMPRESS_RLE else ""))
+    print("%d assets, %d bytes" % (len(assets), len(pack)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Host decoder for the framebuffer mirror (src/core/display_mirror.c).
+
+Reads the packet stream from the watch's USB Serial/JTAG port (or a raw
+capture file), rebuilds every frame and writes them as PNG files together
+with a timing log.
+
+    python tools/fb_mirror.py /dev/ttyACM0 -o frames/
+    python tools/fb_mirror.py capture.bin -o frames/
+
+Requires pyserial for live capture and Pillow for PNG output.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+WIDTH = 240
+HEIGHT = 280
+
+MAGIC = b"FBM1"
+HEADER = struct.Struct("<4sBBHIHHHHH")
+TYPE_RECT = 1
+TYPE_FRAME = 2
+
+OP_SKIP = 0x00
+OP_RUN = 0x40
+OP_LIT = 0x80
+
+
+def fletcher16(data):
+    a = b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return (b << 8) | a
+
+
+def rle565_decode(data, pixels, count):
+    """Decode in place; pixels holds the previous content for skips.
+
+    Mirrors rle565_decode() in lib/rle565. Returns bytes consumed.
+    """
+    pos = 0
+    i = 0
+    while i < count:
+        op = data[pos]
+        pos += 1
+        n = (op & 0x3F) + 1
+        if i + n > count:
+            raise ValueError("op overruns the rectangle")
+        kind = op & 0xC0
+        if kind == OP_RUN:
+            value = data[pos] | (data[pos + 1] << 8)
+            pos += 2
+            pixels[i:i + n] = [value] * n
+        elif kind == OP_LIT:
+            pixels[i:i + n] = struct.unpack_from("<%dH" % n, data, pos)
+            pos += n * 2
+        elif kind != OP_SKIP:
+            raise ValueError("bad op 0x%02x" % op)
+        i += n
+    return pos
+
+
+class Framebuffer:
+    def __init__(self, width=WIDTH, height=HEIGHT):
+        self.width = width
+        self.height = height
+        self.pixels = [0] * (width * height)
+
+    def apply_rect(self, x, y, w, h, payload):
+        rect = []
+        for row in range(h):
+            start = (y + row) * self.width + x
+            rect.extend(self.pixels[start:start + w])
+        rle565_decode(payload, rect, w * h)
+        for row in range(h):
+            start = (y + row) * self.width + x
+            self.pixels[start:start + w] = rect[row * w:(row + 1) * w]
+
+    def to_image(self):
+        from PIL import Image
+
+        rgb = bytearray()
+        for p in self.pixels:
+            r = (p >> 11) & 0x1F
+            g = (p >> 5) & 0x3F
+            b = p & 0x1F
+            rgb += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4),
+                          (b << 3) | (b >> 2)))
+        return Image.frombytes("RGB", (self.width, self.height), bytes(rgb))
+
+
+def packets(stream):
+    """Yield (header fields, payload) from a byte stream.
+
+    Console text interleaved with packets is skipped by resyncing on the
+    magic and checking the checksum.
+    """
+    buf = bytearray()
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(MAGIC)
+            if start < 0:
+                del buf[:-3]
+                break
+            del buf[:start]
+            if len(buf) < HEADER.size:
+                break
+            fields = HEADER.unpack_from(buf)
+            total = HEADER.size + fields[9] + 2
+            if len(buf) < total:
+                break
+            (check,) = struct.unpack_from("<H", buf, total - 2)
+            if fletcher16(buf[4:total - 2]) != check:
+                del buf[:1]  # False magic or corrupt packet
+                continue
+            yield fields, bytes(buf[HEADER.size:total - 2])
+            del buf[:total]
+
+
+def open_source(path, baud):
+    if os.path.exists(path) and not path.startswith("/dev/"):
+        return open(path, "rb"), None
+    import serial
+
+    port = serial.Serial(path, baud, timeout=1)
+    port.write(b"R")  # Ask for a full repaint so skips have a base
+    return port, port
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="serial port or capture file")
+    parser.add_argument("-o", "--out", default="frames",
+                        help="output directory for PNG frames")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--no-png", action="store_true",
+                        help="only print frame timing")
+    args = parser.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    stream, _ = open_source(args.source, args.baud)
+    fb = Framebuffer()
+    frame = 0
+    last_seq = None
+    last_time = None
+    log = open(os.path.join(args.out, "frames.txt"), "w")
+
+    for fields, payload in packets(stream):
+        _, kind, _, seq, time_ms, x, y, w, h, _ = fields
+        if last_seq is not None and seq != (last_seq + 1) & 0xFFFF:
+            print("gap: %d packets lost" % ((seq - last_seq - 1) & 0xFFFF),
+                  file=sys.stderr)
+        last_seq = seq
+
+        if kind == TYPE_RECT:
+            try:
+                fb.apply_rect(x, y, w, h, payload)
+            except (ValueError, IndexError) as err:
+                print("bad rect at seq %d: %s" % (seq, err), file=sys.stderr)
+        elif kind == TYPE_FRAME:
+            delta = time_ms - last_time if last_time is not None else 0
+            last_time = time_ms
+            log.write("%d %d %d\n" % (frame, time_ms, delta))
+            log.flush()
+            if not args.no_png:
+                fb.to_image().save(
+                    os.path.join(args.out, "frame_%05d.png" % frame))
+            print("frame %d  t=%d ms  +%d ms" % (frame, time_ms, delta))
+            frame += 1
+
+
+if __name__ == "__main__":
+    main()
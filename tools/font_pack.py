@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Pack a TrueType font into a glyph file for the font store (src/ui/font_store.c).
+
+The file holds one size of one font: a header, an index sorted by code
+point and 4 bpp glyph bitmaps. Copy it to the ffat partition, e.g. as
+/ffat/fonts/text16.fnt (the partition uses 8.3 file names).
+
+    python tools/font_pack.py NotoSans-Regular.ttf 16 -r 0x20-0x17F \\
+        -r 0x370-0x3FF -r 0x400-0x4FF -o text16.fnt
+
+Requires Pillow.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"WFN1"
+HEADER = struct.Struct("<4sHHbBBBI")
+INDEX = struct.Struct("<IIHBBbbH")
+BPP = 4
+
+
+def parse_range(text):
+    if "-" in text:
+        first, last = text.split("-", 1)
+        return range(int(first, 0), int(last, 0) + 1)
+    return range(int(text, 0), int(text, 0) + 1)
+
+
+def render_glyph(font, ascent, char):
+    from PIL import Image, ImageDraw
+
+    x0, y0, x1, y1 = font.getbbox(char)
+    adv = int(round(font.getlength(char)))
+    w, h = max(x1 - x0, 0), max(y1 - y0, 0)
+    if w == 0 or h == 0:
+        return adv, 0, 0, 0, 0, b""
+    if w > 255 or h > 255:
+        raise ValueError("glyph U+%04X too large" % ord(char))
+
+    image = Image.new("L", (w, h), 0)
+    ImageDraw.Draw(image).text((-x0, -y0), char, font=font, fill=255)
+    pixels = image.tobytes()
+
+    # 4 bpp, high nibble first, rows padded to a byte
+    out = bytearray()
+    for y in range(h):
+        row = pixels[y * w:(y + 1) * w]
+        for x in range(0, w, 2):
+            hi = (row[x] + 8) // 17
+            lo = (row[x + 1] + 8) // 17 if x + 1 < w else 0
+            out.append((hi << 4) | lo)
+    # LVGL: ofs_y is the box bottom's height above the baseline
+    return adv, w, h, x0, ascent - y1, bytes(out)
+
+
+def pack(path, size, codepoints):
+    from PIL import ImageFont
+
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+
+    glyphs = []
+    for cp in sorted(set(codepoints)):
+        char = chr(cp)
+        if cp != 0x20 and font.getmask(char).getbbox() is None:
+            continue  # Not in the font (or blank)
+        glyphs.append((cp,) + render_glyph(font, ascent, char))
+
+    header = HEADER.pack(MAGIC, ascent + descent, descent,
+                         -max(descent // 2, 1), max(size // 16, 1), BPP, 0,
+                         len(glyphs))
+    offset = HEADER.size + INDEX.size * len(glyphs)
+    index = bytearray()
+    bitmaps = bytearray()
+    for cp, adv, w, h, ofs_x, ofs_y, bitmap in glyphs:
+        index += INDEX.pack(cp, offset + len(bitmaps), adv, w, h, ofs_x,
+                            ofs_y, 0)
+        bitmaps += bitmap
+    return header + index + bitmaps, len(glyphs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("font", help="TrueType/OpenType file")
+    parser.add_argument("size", type=int, help="pixel size")
+    parser.add_argument("-r", "--range", action="append", default=[],
+                        help="code point or range, e.g. 0x20-0x7E")
+    parser.add_argument("-t", "--text",
+                        help="file whose characters are included")
+    parser.add_argument("-o", "--out", required=True)
+    args = parser.parse_args()
+
+    codepoints = []
+    for text in args.range or ["0x20-0x7E"]:
+        codepoints.extend(parse_range(text))
+    if args.text:
+        with open(args.text, encoding="utf-8") as f:
+            codepoints.extend(ord(c) for c in f.read() if c >= " ")
+
+    data, count = pack(args.font, args.size, codepoints)
+    with open(args.out, "wb") as f:
+        f.write(data)
+    print("%s: %d glyphs, %d bytes" % (args.out, count, len(data)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
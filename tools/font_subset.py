@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+"""Generate subset copies of LVGL's built-in fonts (run by src/CMakeLists.txt).
+
+For each font in the manifest (tools/fonts.json) the matching LVGL font
+source, e.g. lv_font_montserrat_42.c, is parsed and re-emitted with only
+the glyphs the UI needs, re-quantised to the manifest's bits per pixel.
+Glyphs are the manifest's "chars" plus, with "scan": true, every
+character in the string literals of the UI sources. Kerning classes are
+kept for the remaining glyphs.
+
+    python tools/font_subset.py --manifest tools/fonts.json \\
+        --lvgl managed_components/lvgl__lvgl --scan src/ui --out build/fonts
+
+Files are only rewritten when their content changes, so incremental
+builds are not disturbed. A size report is printed for each font.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+CMAP_FORMAT0_TINY = "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY"
+CMAP_SPARSE_TINY = "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY"
+
+
+class FontError(Exception):
+    pass
+
+
+def c_array(source, name):
+    match = re.search(r"\b%s\s*\[\]\s*=\s*\{(.*?)\};" % re.escape(name),
+                      source, re.S)
+    if match is None:
+        return None
+    body = re.sub(r"/\*.*?\*/", "", match.group(1), flags=re.S)
+    return [int(tok, 0) for tok in re.findall(r"-?(?:0x[0-9a-fA-F]+|\d+)",
+                                              body)]
+
+
+def c_field(source, name):
+    match = re.search(r"\.%s\s*=\s*(-?\d+)" % name, source)
+    if match is None:
+        raise FontError("no .%s" % name)
+    return int(match.group(1))
+
+
+class Font:
+    """Glyphs of an lv_font_fmt_txt font, keyed by code point."""
+
+    def __init__(self, source):
+        self.bpp = c_field(source, "bpp")
+        if c_field(source, "bitmap_format") != 0:
+            raise FontError("compressed fonts are not supported")
+        self.line_height = c_field(source, "line_height")
+        self.base_line = c_field(source, "base_line")
+        self.underline_position = c_field(source, "underline_position")
+        self.underline_thickness = c_field(source, "underline_thickness")
+
+        bitmap = bytes(c_array(source, "glyph_bitmap") or [])
+        dscs = [tuple(int(v) for v in m) for m in re.findall(
+            r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), "
+            r"\.box_h = (\d+), \.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}",
+            source)]
+
+        # Code point -> glyph id
+        self.cmap = {}
+        for m in re.finditer(r"\{\s*\.range_start = (\d+),\s*"
+                             r"\.range_length = (\d+),\s*"
+                             r"\.glyph_id_start = (\d+),\s*"
+                             r"\.unicode_list = (\w+),\s*"
+                             r"\.glyph_id_ofs_list = (\w+),\s*"
+                             r"\.list_length = (\d+),\s*\.type = (\w+)",
+                             source):
+            start, length, gid = int(m.group(1)), int(m.group(2)), int(m.group(3))
+            kind = m.group(7)
+            if kind == CMAP_FORMAT0_TINY:
+                for i in range(length):
+                    self.cmap[start + i] = gid + i
+            elif kind == CMAP_SPARSE_TINY:
+                for i, ofs in enumerate(c_array(source, m.group(4))):
+                    self.cmap[start + ofs] = gid + i
+            else:
+                raise FontError("unsupported cmap type %s" % kind)
+
+        self.glyphs = {}
+        for cp, gid in self.cmap.items():
+            index, adv, w, h, ox, oy = dscs[gid]
+            pixels = unpack(bitmap, index, w * h, self.bpp)
+            self.glyphs[cp] = (gid, adv, w, h, ox, oy, pixels)
+
+        self.kern = None
+        if re.search(r"\.kern_classes = 1", source):
+            self.kern = (c_array(source, "kern_left_class_mapping"),
+                         c_array(source, "kern_right_class_mapping"),
+                         c_array(source, "kern_class_values"),
+                         c_field(source, "right_class_cnt"),
+                         c_field(source, "kern_scale"))
+
+
+def unpack(bitmap, index, count, bpp):
+    """Pixels of a glyph as 0..255, from an MSB-first bit stream."""
+    top = (1 << bpp) - 1
+    out = []
+    bit = index * 8
+    for _ in range(count):
+        byte = bitmap[bit // 8]
+        shift = 8 - bpp - (bit % 8)
+        out.append(((byte >> shift) & top) * 255 // top)
+        bit += bpp
+    return out
+
+
+def pack(pixels, bpp):
+    top = (1 << bpp) - 1
+    out = bytearray()
+    acc = 0
+    bits = 0
+    for value in pixels:
+        acc = (acc << bpp) | ((value * top + 127) // 255)
+        bits += bpp
+        while bits >= 8:
+            bits -= 8
+            out.append((acc >> bits) & 0xFF)
+    if bits:
+        out.append((acc << (8 - bits)) & 0xFF)
+    return bytes(out)
+
+
+def scan_chars(root):
+    """Every character in C string literals under root."""
+    chars = set()
+    literal = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+    for base, _, files in os.walk(root):
+        for name in files:
+            if not name.endswith((".c", ".h")):
+                continue
+            with open(os.path.join(base, name), encoding="utf-8") as f:
+                for text in literal.findall(f.read()):
+                    text = re.sub(r"\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)", "", text)
+                    chars.update(c for c in text if c >= " ")
+    return chars
+
+
+def fmt_list(values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def subset(font, name, codepoints, bpp):
+    """Return (C source, glyph count, bitmap bytes, dsc/cmap/kern bytes)."""
+    kept = sorted(cp for cp in codepoints if cp in font.glyphs)
+
+    bitmap = bytearray()
+    dsc_lines = ["    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, "
+                 ".ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,"]
+    bitmap_lines = []
+    for cp in kept:
+        _, adv, w, h, ox, oy, pixels = font.glyphs[cp]
+        data = pack(pixels, bpp)
+        dsc_lines.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, "
+                         ".box_h = %d, .ofs_x = %d, .ofs_y = %d}, /* U+%04X */"
+                         % (len(bitmap), adv, w, h, ox, oy, cp))
+        bitmap_lines.append("    /* U+%04X */" % cp)
+        if data:
+            bitmap_lines.append(fmt_list(["0x%02x" % b for b in data]))
+        bitmap += data
+
+    offsets = [cp - kept[0] for cp in kept] if kept else []
+    contiguous = offsets == list(range(len(kept)))
+    meta = len(dsc_lines) * 8 + 16
+
+    out = []
+    out.append("/* Generated by tools/font_subset.py - do not edit.\n"
+               " * %d glyphs, %d bpp */\n" % (len(kept), bpp))
+    out.append('#include "lvgl.h"\n')
+    out.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {")
+    out.append("\n".join(bitmap_lines) or "    0x00,")
+    out.append("};\n")
+    out.append("static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {")
+    out.append("\n".join(dsc_lines))
+    out.append("};\n")
+    if not contiguous:
+        out.append("static const uint16_t unicode_list[] = {")
+        out.append(fmt_list(["0x%x" % o for o in offsets]))
+        out.append("};\n")
+        meta += 2 * len(offsets)
+    out.append("static const lv_font_fmt_txt_cmap_t cmaps[] = {")
+    out.append("    {.range_start = %d, .range_length = %d, .glyph_id_start = 1,"
+               % (kept[0] if kept else 0, (offsets[-1] + 1) if kept else 0))
+    out.append("     .unicode_list = %s, .glyph_id_ofs_list = NULL,"
+               % ("NULL" if contiguous else "unicode_list"))
+    out.append("     .list_length = %d, .type = %s},"
+               % (0 if contiguous else len(kept),
+                  CMAP_FORMAT0_TINY if contiguous else CMAP_SPARSE_TINY))
+    out.append("};\n")
+
+    kern_ref = "NULL"
+    kern_scale = 0
+    if font.kern is not None and kept:
+        left_map, right_map, values, right_cnt, kern_scale = font.kern
+        old_left = [left_map[font.glyphs[cp][0]] for cp in kept]
+        old_right = [right_map[font.glyphs[cp][0]] for cp in kept]
+        # Compact to the classes still in use (0 = no kerning)
+        lefts = sorted(set(old_left) - {0})
+        rights = sorted(set(old_right) - {0})
+        if lefts and rights:
+            new_left = [lefts.index(c) + 1 if c else 0 for c in old_left]
+            new_right = [rights.index(c) + 1 if c else 0 for c in old_right]
+            pair_values = [values[(l - 1) * right_cnt + (r - 1)]
+                           for l in lefts for r in rights]
+            out.append("static const uint8_t kern_left_class_mapping[] = {")
+            out.append(fmt_list([str(v) for v in [0] + new_left]))
+            out.append("};\n")
+            out.append("static const uint8_t kern_right_class_mapping[] = {")
+            out.append(fmt_list([str(v) for v in [0] + new_right]))
+            out.append("};\n")
+            out.append("static const int8_t kern_class_values[] = {")
+            out.append(fmt_list([str(v) for v in pair_values]))
+            out.append("};\n")
+            out.append("static const lv_font_fmt_txt_kern_classes_t kern_classes = {")
+            out.append("    .class_pair_values = kern_class_values,")
+            out.append("    .left_class_mapping = kern_left_class_mapping,")
+            out.append("    .right_class_mapping = kern_right_class_mapping,")
+            out.append("    .left_class_cnt = %d," % len(lefts))
+            out.append("    .right_class_cnt = %d," % len(rights))
+            out.append("};\n")
+            kern_ref = "&kern_classes"
+            meta += 2 * (len(kept) + 1) + len(pair_values)
+
+    out.append("static const lv_font_fmt_txt_dsc_t font_dsc = {")
+    out.append("    .glyph_bitmap = glyph_bitmap,")
+    out.append("    .glyph_dsc = glyph_dsc,")
+    out.append("    .cmaps = cmaps,")
+    out.append("    .kern_dsc = %s," % kern_ref)
+    out.append("    .kern_scale = %d," % kern_scale)
+    out.append("    .cmap_num = 1,")
+    out.append("    .bpp = %d," % bpp)
+    out.append("    .kern_classes = %d," % (1 if kern_ref != "NULL" else 0))
+    out.append("    .bitmap_format = 0,")
+    out.append("};\n")
+    out.append("const lv_font_t %s = {" % name)
+    out.append("    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,")
+    out.append("    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,")
+    out.append("    .line_height = %d," % font.line_height)
+    out.append("    .base_line = %d," % font.base_line)
+    out.append("    .subpx = LV_FONT_SUBPX_NONE,")
+    out.append("    .underline_position = %d," % font.underline_position)
+    out.append("    .underline_thickness = %d," % font.underline_thickness)
+    out.append("    .dsc = &font_dsc,")
+    out.append("    .fallback = NULL,")
+    out.append("    .user_data = NULL,")
+    out.append("};")
+    return "\n".join(out) + "\n", len(kept), len(bitmap), meta
+
+
+def full_size(font):
+    """Bytes the complete source font puts in flash (approximate)."""
+    bitmap = sum(len(pack(g[6], font.bpp)) for g in font.glyphs.values())
+    meta = (len(font.glyphs) + 1) * 8 + 16
+    if font.kern is not None:
+        meta += 2 * (len(font.glyphs) + 1) + len(font.kern[2])
+    return bitmap + meta
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return False
+    except FileNotFoundError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--manifest", required=True)
+    parser.add_argument("--lvgl", required=True, help="LVGL source tree")
+    parser.add_argument("--scan", action="append", default=[],
+                        help="source directory scanned for string literals")
+    parser.add_argument("--out", required=True)
+    args = parser.parse_args()
+
+    with open(args.manifest, encoding="utf-8") as f:
+        manifest = json.load(f)
+
+    scanned = set()
+    for root in args.scan:
+        scanned |= scan_chars(root)
+
+    os.makedirs(args.out, exist_ok=True)
+    total_before = total_after = 0
+    for entry in manifest["fonts"]:
+        path = os.path.join(args.lvgl, "src", "font", entry["source"])
+        with open(path, encoding="utf-8") as f:
+            try:
+                font = Font(f.read())
+            except FontError as err:
+                sys.exit("%s: %s" % (path, err))
+
+        chars = set(entry.get("chars", ""))
+        if entry.get("scan", False):
+            chars |= scanned
+        text, count, bitmap, meta = subset(font, entry["name"],
+                                    {ord(c) for c in chars},
+                                    entry.get("bpp", font.bpp))
+        write_if_changed(os.path.join(args.out, entry["name"] + ".c"), text)
+
+        before = full_size(font)
+        after = bitmap + meta
+        total_before += before
+        total_after += after
+        missing = sorted(c for c in chars if ord(c) not in font.glyphs)
+        print("%s: %d -> %d glyphs, %d -> %d bpp, %d -> %d bytes%s"
+              % (entry["name"], len(font.glyphs), count, font.bpp,
+                 entry.get("bpp", font.bpp), before, after,
+                 " (not in font: %r)" % "".join(missing) if missing else ""))
+
+    print("fonts: %d -> %d bytes, %d bytes saved"
+          % (total_before, total_after, total_before - total_after))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""Compile a watchface description into a .wfc file for src/ui/watchface_file.c.
+
+The text form lists the face's primitives, what drives them and the
+palette, one statement per line ('#' starts a comment):
+
+    palette          white=#F5F5F5 black=#1A1A1A orange=#FF6347
+    ambient_palette  white=#FFFFFF black=#FFFFFF orange=#FF0000
+    ambient_rows     60 145            # rows kept lit in ambient mode
+    layer            12 12 26 19       # static area baked into an image
+    source clock     0 "%H:%M"         # text slot 0 <- strftime()
+    source battery   0 5               # value slot 0 <- level * 5 / 100
+    source steps     1 15              # value slot 1 <- steps * 15 / goal
+
+    rect   X Y W H color=C [radius=N|circle] [on=C level=SLOT:INDEX]
+                   [track=SLOT:STEP] [ambient]
+    text   X Y W H color=C font=F (slot=N | text="...") [ambient]
+    digits X Y W H color=C font=F slot=N [ambient]
+    image  X Y W H src=ASSET
+    repeat N DX DY <primitive>         # copy i at +i*DX, +i*DY and
+                                       # level=SLOT:INDEX:STEP moves on
+
+Fonts are large, medium, normal, small and tiny (the theme's). Large and
+medium are subsets (tools/fonts.json): the firmware rejects faces whose
+text or clock formats need glyphs the font lacks. Text may use \\uXXXX
+escapes for LVGL symbols. The output goes to the ffat
+partition as /ffat/faces/NAME.wfc (8.3 names):
+
+    python tools/wfc.py tools/faces/morse.wf -o morse.wfc
+"""
+
+import argparse
+import re
+import shlex
+import struct
+import sys
+
+MAGIC = b"WFC1"
+VERSION = 1
+HEADER = struct.Struct("<4sHHBBHHHHH16I")
+LAYER = struct.Struct("<4h")
+PRIM = struct.Struct("<8B5hBBHH")
+SOURCE = struct.Struct("<BBBBHH")
+
+PALETTE_SIZE = 8
+VALUE_SLOTS = 8
+TEXT_SLOTS = 4
+TEXT_MAX = 24  # Bytes per text slot, with the terminator
+MAX_LAYERS = 4
+RADIUS_CIRCLE = 0xFF
+FLAG_AMBIENT = 0x01
+
+PRIM_TYPES = {"rect": 0, "text": 1, "digits": 2, "image": 3}
+BIND_NONE, BIND_LEVEL, BIND_TRACK, BIND_TEXT = range(4)
+SOURCES = {"clock": 0, "battery": 1, "steps": 2}
+FONTS = {"large": 1, "medium": 2, "normal": 3, "small": 4, "tiny": 5}
+ASSET_PREFIX = "asset:"
+# Longest strftime output per conversion in the C locale (as the firmware)
+CONVERSION_LEN = {c: n for convs, n in (
+    ("CdgHImMSUVWy", 2), ("uw", 1), ("j", 3), ("GY", 4), ("ekl", 2),
+    ("R", 5), ("TX", 8), ("Dx", 8), ("F", 10), ("r", 11), ("p", 2),
+    ("a", 3), ("A", 9), ("bh", 3), ("B", 9), ("c", 24), ("%", 1))
+    for c in convs}
+PANEL_W, PANEL_H = 240, 280
+
+
+class FaceError(Exception):
+    pass
+
+
+class Face:
+    def __init__(self):
+        self.palette = {}  # name -> (index, colour)
+        self.ambient = {}
+        self.ambient_rows = (0, 0)
+        self.layers = []
+        self.sources = []
+        self.prims = []
+        self.strings = bytearray()
+        self.string_offsets = {}
+
+    def string(self, text):
+        """Offset + 1 of text in the string table (0 = none)."""
+        data = text.encode("utf-8")
+        if data not in self.string_offsets:
+            self.string_offsets[data] = len(self.strings) + 1
+            self.strings += data + b"\0"
+        return self.string_offsets[data]
+
+    def color(self, name):
+        if name not in self.palette:
+            raise FaceError("unknown colour %s" % name)
+        return self.palette[name][0]
+
+
+def number(text):
+    try:
+        return int(text, 0)
+    except ValueError:
+        raise FaceError("not a number: %s" % text)
+
+
+def slot_pair(text):
+    parts = [number(p) for p in text.split(":")]
+    if len(parts) not in (2, 3):
+        raise FaceError("expected SLOT:N[:STEP], got %s" % text)
+    return parts + [1] * (3 - len(parts))
+
+
+def unescape(text):
+    return re.sub(r"\\u([0-9a-fA-F]{4})", lambda m: chr(int(m.group(1), 16)),
+                  text)
+
+
+def parse_colors(face, args, target):
+    for arg in args:
+        name, _, value = arg.partition("=")
+        if not value.startswith("#") or len(value) != 7:
+            raise FaceError("expected NAME=#RRGGBB, got %s" % arg)
+        if target is face.palette:
+            if len(face.palette) >= PALETTE_SIZE and name not in face.palette:
+                raise FaceError("more than %d colours" % PALETTE_SIZE)
+            index = face.palette.get(name, (len(face.palette), 0))[0]
+        else:
+            index = face.color(name)
+        target[name] = (index, int(value[1:], 16))
+
+
+def parse_prim(face, kind, args, copy=0, dx=0, dy=0):
+    if kind not in PRIM_TYPES or len(args) < 4:
+        raise FaceError("expected %s X Y W H ..." % kind)
+    x, y, w, h = (number(a) for a in args[:4])
+    prim = {"type": PRIM_TYPES[kind], "bind": BIND_NONE, "slot": 0,
+            "index": 0, "radius": 0, "color": 0, "color_on": 0, "flags": 0,
+            "x": x + copy * dx, "y": y + copy * dy, "w": w, "h": h,
+            "step": 0, "font": 0, "text": 0}
+
+    for arg in args[4:]:
+        key, _, value = arg.partition("=")
+        if key == "ambient" and not value:
+            prim["flags"] |= FLAG_AMBIENT
+        elif key == "color":
+            prim["color"] = face.color(value)
+        elif key == "on":
+            prim["color_on"] = face.color(value)
+        elif key == "radius":
+            prim["radius"] = RADIUS_CIRCLE if value == "circle" else \
+                number(value)
+        elif key == "level":
+            slot, index, step = slot_pair(value)
+            prim.update(bind=BIND_LEVEL, slot=slot, index=index + copy * step)
+        elif key == "track":
+            slot, step, _ = slot_pair(value)
+            prim.update(bind=BIND_TRACK, slot=slot, step=step)
+        elif key == "slot":
+            prim.update(bind=BIND_TEXT, slot=number(value))
+        elif key == "font":
+            if value not in FONTS:
+                raise FaceError("unknown font %s" % value)
+            prim["font"] = FONTS[value]
+        elif key == "text":
+            prim["text"] = face.string(unescape(value))
+        elif key == "src":
+            prim["text"] = face.string(ASSET_PREFIX + value)
+        else:
+            raise FaceError("unknown attribute %s" % arg)
+
+    slots = TEXT_SLOTS if prim["bind"] == BIND_TEXT else VALUE_SLOTS
+    if prim["slot"] >= slots or not 0 <= prim["index"] <= 255:
+        raise FaceError("slot or level out of range")
+    if kind in ("text", "digits") and prim["font"] == 0:
+        raise FaceError("%s needs a font" % kind)
+    if kind == "image" and prim["text"] == 0:
+        raise FaceError("image needs src")
+    face.prims.append(prim)
+
+
+def parse(lines):
+    face = Face()
+    for line_no, line in enumerate(lines, 1):
+        try:
+            words = shlex.split(line)
+            for i, word in enumerate(words):
+                if word.startswith("#"):
+                    words = words[:i]
+                    break
+            if not words:
+                continue
+            kind, args = words[0], words[1:]
+            if kind == "palette":
+                parse_colors(face, args, face.palette)
+            elif kind == "ambient_palette":
+                parse_colors(face, args, face.ambient)
+            elif kind == "ambient_rows":
+                if len(args) != 2:
+                    raise FaceError("expected ambient_rows START END")
+                face.ambient_rows = tuple(number(a) for a in args[:2])
+                start, end = face.ambient_rows
+                if end > start and end >= PANEL_H:
+                    raise FaceError("ambient rows off the panel")
+            elif kind == "layer":
+                if len(face.layers) >= MAX_LAYERS:
+                    raise FaceError("more than %d layers" % MAX_LAYERS)
+                if len(args) != 4:
+                    raise FaceError("expected layer X1 Y1 X2 Y2")
+                x1, y1, x2, y2 = (number(a) for a in args[:4])
+                if not (0 <= x1 <= x2 < PANEL_W and 0 <= y1 <= y2 < PANEL_H):
+                    raise FaceError("layer off the panel")
+                face.layers.append((x1, y1, x2, y2))
+            elif kind == "source":
+                if len(args) != 3 or args[0] not in SOURCES:
+                    raise FaceError("expected source KIND SLOT ARG")
+                if args[0] == "clock":
+                    if format_len(args[2]) >= TEXT_MAX:
+                        raise FaceError("clock format can exceed %d bytes"
+                                        % (TEXT_MAX - 1))
+                    source = (SOURCES["clock"], number(args[1]), 0,
+                              face.string(args[2]))
+                else:
+                    source = (SOURCES[args[0]], number(args[1]),
+                              number(args[2]), 0)
+                face.sources.append(source)
+            elif kind == "repeat":
+                count, dx, dy = (number(a) for a in args[:3])
+                for copy in range(count):
+                    parse_prim(face, args[3], args[4:], copy, dx, dy)
+            else:
+                parse_prim(face, kind, args)
+        except (FaceError, ValueError, IndexError) as err:
+            raise FaceError("line %d: %s" % (line_no, err))
+    if not face.prims:
+        raise FaceError("no primitives")
+    return face
+
+
+def format_len(fmt):
+    """Longest text a clock format can produce, in bytes."""
+    length = 0
+    parts = iter(fmt)
+    for char in parts:
+        if char != "%":
+            length += len(char.encode("utf-8"))
+            continue
+        conversion = next(parts, "")
+        if conversion not in CONVERSION_LEN:
+            raise FaceError("unsupported conversion %%%s" % conversion)
+        length += CONVERSION_LEN[conversion]
+    return length
+
+
+def build(face):
+    palette = [0] * PALETTE_SIZE
+    ambient = [0] * PALETTE_SIZE
+    for index, color in face.palette.values():
+        palette[index] = color
+        ambient[index] = color
+    for index, color in face.ambient.values():
+        ambient[index] = color
+
+    if len(face.strings) > 0xFFFF or len(face.prims) > 0xFFFF:
+        raise FaceError("face too large")
+    out = bytearray(HEADER.pack(
+        MAGIC, VERSION, len(face.prims), len(face.layers), len(face.sources),
+        face.ambient_rows[0], face.ambient_rows[1], len(face.strings), 0, 0,
+        *(palette + ambient)))
+    for layer in face.layers:
+        out += LAYER.pack(*layer)
+    for p in face.prims:
+        out += PRIM.pack(p["type"], p["bind"], p["slot"], p["index"],
+                         p["radius"], p["color"], p["color_on"], p["flags"],
+                         p["x"], p["y"], p["w"], p["h"], p["step"],
+                         p["font"], 0, p["text"], 0)
+    for kind, slot, arg, fmt in face.sources:
+        out += SOURCE.pack(kind, slot, arg, 0, fmt, 0)
+    out += face.strings
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="face description (.wf)")
+    parser.add_argument("-o", "--out", required=True)
+    args = parser.parse_args()
+
+    try:
+        with open(args.input, encoding="utf-8") as src:
+            face = parse(src.readlines())
+        data = build(face)
+    except (OSError, FaceError) as err:
+        sys.exit("wfc: %s" % err)
+
+    with open(args.out, "wb") as out:
+        out.write(data)
+    print("%d primitives, %d layers, %d sources, %d bytes" % (
+        len(face.prims), len(face.layers), len(face.sources), len(data)))
+
+
+if __name__ == "__main__":
+    main()